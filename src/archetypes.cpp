@@ -0,0 +1,92 @@
+#include "archetypes.h"
+#include <algorithm>
+
+EnemyArchetype EnemyArchetypes::build(
+	const EnemyParams & params
+	, const int vertices
+	, const sf::Color & outline_color
+) {
+	// Size, collider and score grow with every vertex above the minimum
+	const int steps = vertices - params.vertices_min;
+	const float size_mult = (params.vert_size_multiplier - 1) * steps;
+	const float radius = params.shape_radius + params.shape_radius * size_mult;
+	const int collision_radius = params.collision_radius + params.collision_radius * size_mult;
+	const int score = params.score + params.score * ((params.score_size_multiplier - 1) * steps);
+	const CShape fragment(
+		params.small_radius
+		, vertices
+		, sf::Color(0, 0, 0)
+		, outline_color
+		, params.outline_thickness
+	);
+	const int recursion = 0;
+	return EnemyArchetype {
+		vertices
+		, CShape(radius, vertices, sf::Color(0, 0, 0), outline_color, params.outline_thickness)
+		, CCollider(collision_radius)
+		, CHealth(vertices)
+		, CInvincibility(params.invincibility_duration)
+		, CScoreReward(score)
+		, CDeathSpawner(vertices, fragment, params.small_lifespan, params.small_speed, recursion, Tag::Enemies)
+		, std::nullopt
+	};
+}
+
+void EnemyArchetypes::build(const GameParams & params) {
+	m_enemies.clear();
+	m_bosses.clear();
+	const EnemyParams & enemy = params.enemy;
+	for (int v = enemy.vertices_min; v <= std::max(enemy.vertices_min, enemy.vertices_max); ++v) {
+		m_enemies.push_back(build(enemy, v, enemy.outline_color));
+	}
+
+	const BossParams & boss = params.boss;
+	const sf::Color & base = boss.outline_color;
+	// Each pickup maxes out one channel of the boss outline
+	const sf::Color tints[pickup_types] = {
+		sf::Color(255, base.g, base.b),
+		sf::Color(base.r, 255, base.b),
+		sf::Color(base.r, base.g, 255),
+	};
+	const PickupParams & pickup = params.pickup;
+	for (int v = boss.vertices_min; v <= std::max(boss.vertices_min, boss.vertices_max); ++v) {
+		for (int type = 0; type < pickup_types; ++type) {
+			EnemyArchetype archetype = build(boss, v, tints[type]);
+			const CShape pickup_shape(
+				pickup.shape_radius
+				, pickup.vertices
+				, tints[type]
+				, sf::Color(0, 0, 0)
+				, pickup.outline_thickness
+			);
+			archetype.pickup_spawner = CPickupSpawner(
+				CWeaponPickup(static_cast<CWeaponPickup::PickupType>(type))
+				, pickup_shape
+				, pickup.lifespan
+				, pickup.collision_radius
+			);
+			m_bosses.push_back(archetype);
+		}
+	}
+}
+
+const EnemyArchetype & EnemyArchetypes::pick(const bool boss, Rng & rng) const {
+	if (boss) {
+		const int vertex_counts = static_cast<int>(m_bosses.size()) / pickup_types;
+		const int v = rng.range(0, vertex_counts - 1);
+		return m_bosses[v * pickup_types + rng.range(0, pickup_types - 1)];
+	}
+	return m_enemies[rng.range(0, static_cast<int>(m_enemies.size()) - 1)];
+}
+
+float EnemyArchetypes::max_collision_radius(const bool boss) const {
+	float radius = 0.f;
+	for (const EnemyArchetype & archetype : boss ? m_bosses : m_enemies) {
+		radius = std::max(radius, archetype.collider.radius);
+	}
+	return radius;
+}
+
+size_t EnemyArchetypes::size() const {
+	return m_enemies.size() + m_bosses.size();
+}
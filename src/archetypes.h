@@ -0,0 +1,42 @@
+#pragma once
+#include <optional>
+#include <vector>
+#include "component.h"
+#include "params.h"
+#include "rng.h"
+
+// Everything about a spawned enemy that does not depend on where it
+// spawns or how it moves: built once per vertex count when the config is
+// compiled and copied onto new entities as is.
+struct EnemyArchetype {
+	int vertices;
+	CShape shape;
+	CCollider collider;
+	CHealth health;
+	CInvincibility invincibility;
+	CScoreReward score_reward;
+	CDeathSpawner spawner; // holds the fragment prefab
+	std::optional<CPickupSpawner> pickup_spawner; // bosses only
+};
+
+// Enemy archetypes per vertex count; boss archetypes per vertex count and
+// the weapon pickup they drop (which also tints their outline).
+class EnemyArchetypes {
+	std::vector<EnemyArchetype> m_enemies {};
+	std::vector<EnemyArchetype> m_bosses {};
+	static const int pickup_types = CWeaponPickup::PickupType::ShotLaser + 1;
+	static EnemyArchetype build(
+		const EnemyParams & params
+		, const int vertices
+		, const sf::Color & outline_color
+	);
+public:
+	EnemyArchetypes() {};
+	~EnemyArchetypes() {};
+	void build(const GameParams & params);
+	// A random vertex count (and pickup, for bosses)
+	const EnemyArchetype & pick(const bool boss, Rng & rng) const;
+	// The biggest collider a pick can return
+	float max_collision_radius(const bool boss) const;
+	size_t size() const;
+};
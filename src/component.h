@@ -1,11 +1,10 @@
 #pragma once
 #include "vec2.h"
+#include <algorithm>
 #include <iostream>
 #include <map>
-#include <SFML/Graphics/CircleShape.hpp>
-#include <SFML/Graphics/RectangleShape.hpp>
+#include <SFML/Graphics/Color.hpp>
 #include <SFML/Graphics/Rect.hpp>
-#include <SFML/Graphics/Text.hpp>
 #include "tag.h"
 
 enum ComponentType {
@@ -89,6 +88,25 @@ class Component {
 public:
 };
 
+// A countdown kept as the simulation tick it runs out on (Game::m_tick),
+// so nothing has to count it down every frame; the time left is worked
+// out when somebody asks. Components are built before their entity is
+// added, so until then the deadline counts from 0 and arm() moves it to
+// the tick the entity joins the world on.
+struct Timer {
+	size_t deadline {0};
+	Timer(const int ticks = 0) : deadline(std::max(ticks, 0)) { }
+	void arm(const size_t now) {
+		deadline += now;
+	}
+	void start(const size_t now, const int ticks) {
+		deadline = now + std::max(ticks, 0);
+	}
+	int remaining(const size_t now) const {
+		return deadline > now ? (int)(deadline - now) : 0;
+	}
+};
+
 class CTransform : public Component {
 public:
 	Vec2 position {0.f, 0.f};
@@ -156,26 +174,46 @@ public:
 
 class CShape : public Component {
 public:
-	sf::CircleShape shape;
+	float radius {30.f};
+	size_t point_count {8};
+	sf::Color fill_color {sf::Color(0, 255, 0)};
+	sf::Color outline_color {sf::Color(255, 255, 255)};
+	float outline_thickness {1.f};
+	float rotation {0.f}; // degrees, spun by sRender
+	float scale {1.f}; // damage reaction expansion
+	// Bumped by the setters. The render side also compares radius, colours
+	// and outline with its cached vertices, so direct writes are picked up
+	// too; this only forces a rebuild.
+	unsigned int version {0};
 	CShape(
-		const float radius = 30.f
-		, const size_t point_count = 8
-		, const sf::Color fill_color = sf::Color(0, 255, 0)
-		, const sf::Color outline_color = sf::Color(255, 255, 255)
-		, const float outline_thickness = 1.f
+		const float in_radius = 30.f
+		, const size_t in_point_count = 8
+		, const sf::Color in_fill_color = sf::Color(0, 255, 0)
+		, const sf::Color in_outline_color = sf::Color(255, 255, 255)
+		, const float in_outline_thickness = 1.f
 	)
-		: shape(sf::CircleShape(radius, point_count)) 
-	{
-		shape.setFillColor(fill_color);
-		shape.setOutlineColor(outline_color);
-		shape.setOutlineThickness(outline_thickness);
-		shape.setOrigin(radius, radius);
-	}
+		: radius(in_radius)
+		, point_count(in_point_count)
+		, fill_color(in_fill_color)
+		, outline_color(in_outline_color)
+		, outline_thickness(in_outline_thickness)
+	{ }
 	~CShape() { }
+	void set_alpha(const sf::Uint8 alpha) {
+		if (fill_color.a != alpha || outline_color.a != alpha) {
+			fill_color.a = alpha;
+			outline_color.a = alpha;
+			++version;
+		}
+	}
 };
 
 class CEmitter : public Component {
 public:
+	// Which ParticleSystem pool the particles go to
+	enum ParticleType {
+		Flame,
+	};
 	const CTransform & parent;
 	const std::vector<CShape> particles;
 	const Vec2 offset;
@@ -183,10 +221,11 @@ public:
 	const float nozzleSpread;
 	const float speed;
 	const int freq;
-	int countdown;
+	Timer countdown;
 	const int quantity;
 	const int lifespan;
 	const float scale_mult;
+	const ParticleType type;
 	CEmitter(
 		const CTransform & in_parent,
 		const std::vector<CShape> & particle_prefabs,
@@ -198,7 +237,8 @@ public:
 		const int emit_freq,
 		const int in_quantity,
 		const int in_lifespan,
-		const float random_scale_mult
+		const float random_scale_mult,
+		const ParticleType in_type = ParticleType::Flame
 	)
 		: parent(in_parent)
 		, particles(particle_prefabs)
@@ -211,6 +251,7 @@ public:
 		, quantity(in_quantity)
 		, lifespan(in_lifespan)
 		, scale_mult(random_scale_mult)
+		, type(in_type)
 	{ }
 	~CEmitter() { };
 };
@@ -226,7 +267,7 @@ public:
 class CLifespan : public Component {
 public:
 	int duration {10};
-	int countdown {10};
+	Timer countdown {10};
 	CLifespan() { }
 	CLifespan(const int span) : countdown(span), duration(span) { }
 	~CLifespan() { }
@@ -234,7 +275,7 @@ public:
 
 class CInvincibility : public Component {
 public:
-	int countdown {10};
+	Timer countdown {10};
 	int duration {10};
 	CInvincibility() { }
 	CInvincibility(const int in_duration, const int start = 0) : countdown(start), duration(in_duration) { }
@@ -246,7 +287,7 @@ public:
 	int max_hp;
 	int hp;
 	int react_duration;
-	int react_countdown;
+	Timer react_countdown;
 	float expansion;
 	CHealth(
 		int in_hp = 1
@@ -267,45 +308,51 @@ public:
 class CLine: public Component {
 public:
 	const CTransform & parent;
-	sf::RectangleShape shape;
 	const Vec2 start;
 	const Vec2 end;
+	float thickness;
+	sf::Color fill_color;
+	sf::Color outline_color;
+	float outline_thickness;
+	// start / end in world space, refreshed once a frame by sMovement
+	Vec2 world_start;
+	Vec2 world_end;
 	CLine(
 		const CTransform & in_parent_transform
 		, const Vec2 & in_start = Vec2(0, 0)
 		, const Vec2 & in_end = Vec2(1, 0)
-		, const float thickness = 1.f
-		, const sf::Color & fill_color = sf::Color(0, 0, 255)
-		, const sf::Color & outline_color = sf::Color(0, 0, 255)        
-		, const float outline_thickness = 1.f
+		, const float in_thickness = 1.f
+		, const sf::Color & in_fill_color = sf::Color(0, 0, 255)
+		, const sf::Color & in_outline_color = sf::Color(0, 0, 255)        
+		, const float in_outline_thickness = 1.f
 	)
 		: parent(in_parent_transform)
 		, start(in_start)
 		, end(in_end)
-		, shape(sf::RectangleShape(sf::Vector2f(in_start.distance_to(in_end), thickness)))
-	{
-		shape.setFillColor(fill_color);
-		shape.setOutlineColor(outline_color);
-		shape.setOutlineThickness(outline_thickness);
-		shape.setOrigin(0, thickness / 2);
-		shape.setRotation(start.angle_to_deg(end));
-	}
+		, thickness(in_thickness)
+		, fill_color(in_fill_color)
+		, outline_color(in_outline_color)
+		, outline_thickness(in_outline_thickness)
+		, world_start(in_parent_transform.position + in_start.clone().rotate_rad(in_parent_transform.rotation))
+		, world_end(in_parent_transform.position + in_end.clone().rotate_rad(in_parent_transform.rotation))
+	{ }
 };
 
 class CText : public Component {
 public:
-	sf::Text text;
-	sf::Color color;
+	std::string string {"default"};
+	unsigned int size {24};
+	sf::Color color {sf::Color(255, 255, 255)};
+	float scale {1.f}; // damage reaction expansion
 	CText(
 		const std::string & innerText = "default",
-		const sf::Font & font = sf::Font(),
-		const unsigned int size = 24,
-		const sf::Color & color = sf::Color(255, 255, 255)
+		const unsigned int in_size = 24,
+		const sf::Color & in_color = sf::Color(255, 255, 255)
 	)
-		: text(sf::Text(innerText, font, size))
-	{
-		text.setColor(color);
-	}
+		: string(innerText)
+		, size(in_size)
+		, color(in_color)
+	{ }
 	~CText() { }
 };
 
@@ -316,7 +363,7 @@ public:
 		ShotSpread,
 		ShotLaser
 	};
-	int fire_countdown {10};
+	Timer fire_countdown {10};
 	int power {0};
 	CWeapon::FireMode mode {CWeapon::FireMode::ShotSingle};
 	CWeapon(
@@ -335,7 +382,7 @@ public:
 		SpecialFlamethrower,
 	};
 	CSpecialWeapon::FireMode mode;
-	int fire_countdown {10};
+	Timer fire_countdown {10};
 	int power {0};
 	CSpecialWeapon(
 		const CSpecialWeapon::FireMode fire_mode = CSpecialWeapon::FireMode::SpecialExplosion
@@ -0,0 +1,136 @@
+#include "config.h"
+#include <algorithm>
+#include <charconv>
+#include <cstdlib>
+#include <stdexcept>
+
+uint32_t Config::intern(const std::string_view name) {
+	const uint64_t hash = fnv1a(name);
+	const auto found = m_name_ids.find(hash);
+	if (found != m_name_ids.end()) {
+		if (m_names[found->second] != name) {
+			throw std::runtime_error("Config name hash collision: " + std::string(name)
+				+ " / " + m_names[found->second]);
+		}
+		return found->second;
+	}
+	const uint32_t id = static_cast<uint32_t>(m_names.size());
+	m_names.push_back(std::string(name));
+	m_name_ids.emplace(hash, id);
+	return id;
+}
+
+size_t Config::probe(const uint64_t hash) const {
+	const size_t mask = m_slots.size() - 1;
+	size_t idx = hash & mask;
+	while (m_slots[idx].used && m_slots[idx].hash != hash) {
+		idx = (idx + 1) & mask;
+	}
+	return idx;
+}
+
+void Config::grow() {
+	std::vector<Slot> old = std::move(m_slots);
+	m_slots = std::vector<Slot>(old.empty() ? 64 : old.size() * 2);
+	for (Slot & slot : old) {
+		if (slot.used) {
+			m_slots[probe(slot.hash)] = std::move(slot);
+		}
+	}
+}
+
+void Config::parse(Value & value, const std::string_view text) {
+	value.text = text;
+	const char * begin = text.data();
+	const char * end = begin + text.size();
+	int i = 0;
+	const auto [int_end, int_error] = std::from_chars(begin, end, i);
+	if (int_error == std::errc() && int_end == end) {
+		value.type = Int;
+		value.i = i;
+		value.f = static_cast<float>(i);
+		return;
+	}
+	char * float_end = nullptr;
+	const float f = text.empty() ? 0.f : std::strtof(value.text.c_str(), &float_end);
+	if (!text.empty() && *float_end == '\0') {
+		value.type = Float;
+		value.i = static_cast<int>(f);
+		value.f = f;
+		return;
+	}
+	value.type = String;
+	value.i = -1;
+	value.f = -1.f;
+}
+
+void Config::set(const std::string_view header, const std::string_view item, const std::string_view text) {
+	if ((m_size + 1) * 2 > m_slots.size()) {
+		grow();
+	}
+	const ConfigKey key(header, item);
+	Slot & slot = m_slots[probe(key.hash)];
+	const uint32_t header_id = intern(header);
+	const uint32_t item_id = intern(item);
+	if (slot.used && (slot.header != header_id || slot.item != item_id)) {
+		throw std::runtime_error("Config key hash collision: " + std::string(header)
+			+ ":" + std::string(item));
+	}
+	if (!slot.used) {
+		slot.used = true;
+		slot.hash = key.hash;
+		slot.header = header_id;
+		slot.item = item_id;
+		++m_size;
+	}
+	parse(slot.value, text);
+}
+
+bool Config::assign(const ConfigKey key, const std::string_view text) {
+	if (m_slots.empty()) {
+		return false;
+	}
+	Slot & slot = m_slots[probe(key.hash)];
+	if (!slot.used) {
+		return false;
+	}
+	parse(slot.value, text);
+	return true;
+}
+
+const Config::Value * Config::find(const ConfigKey key) const {
+	if (m_slots.empty()) {
+		return nullptr;
+	}
+	const Slot & slot = m_slots[probe(key.hash)];
+	return slot.used ? &slot.value : nullptr;
+}
+
+size_t Config::size() const {
+	return m_size;
+}
+
+bool Config::empty() const {
+	return m_size == 0;
+}
+
+void Config::clear() {
+	m_names.clear();
+	m_name_ids.clear();
+	m_slots.clear();
+	m_size = 0;
+}
+
+std::vector<Config::Entry> Config::entries() const {
+	std::vector<Entry> result;
+	result.reserve(m_size);
+	for (const Slot & slot : m_slots) {
+		if (slot.used) {
+			result.push_back(Entry {m_names[slot.header], m_names[slot.item], &slot.value});
+		}
+	}
+	std::sort(result.begin(), result.end(), [](const Entry & a, const Entry & b) {
+		return a.header != b.header ? a.header < b.header : a.item < b.item;
+	});
+	return result;
+}
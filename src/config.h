@@ -0,0 +1,90 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+// 64 bit FNV-1a
+constexpr uint64_t fnv1a(const std::string_view text, uint64_t hash = 14695981039346656037ull) {
+	for (const char c : text) {
+		hash ^= static_cast<unsigned char>(c);
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+// A header or key name, hashed once (at compile time for constants)
+struct ConfigName {
+	uint64_t hash {0};
+	constexpr ConfigName() {}
+	constexpr ConfigName(const char * name) : hash(fnv1a(name)) {}
+	constexpr ConfigName(const std::string_view name) : hash(fnv1a(name)) {}
+	constexpr ConfigName(const std::string & name) : hash(fnv1a(name)) {}
+	// The name with suffix appended, without hashing the prefix again
+	constexpr ConfigName operator+(const std::string_view suffix) const {
+		ConfigName name;
+		name.hash = fnv1a(suffix, hash);
+		return name;
+	}
+};
+
+// Header + key, combined from the two name hashes without rehashing text
+struct ConfigKey {
+	uint64_t hash {0};
+	constexpr ConfigKey(const ConfigName header, const ConfigName item)
+		: hash((header.hash * 0x9e3779b97f4a7c15ull) ^ item.hash) {}
+};
+
+// Values of a config file, keyed by header and key.
+// Header and key names are interned to small ids; the values sit in one
+// flat open addressing table indexed by ConfigKey, each parsed once into
+// int, float or string when it is stored.
+class Config {
+public:
+	enum Type {
+		Int,
+		Float,
+		String,
+	};
+	struct Value {
+		Type type {String};
+		int i {-1};
+		float f {-1.f};
+		std::string text {};
+	};
+	struct Entry {
+		std::string_view header;
+		std::string_view item;
+		const Value * value;
+	};
+private:
+	struct Slot {
+		uint64_t hash {0};
+		uint32_t header {0};
+		uint32_t item {0};
+		bool used {false};
+		Value value {};
+	};
+	std::vector<std::string> m_names {};
+	std::unordered_map<uint64_t, uint32_t> m_name_ids {};
+	std::vector<Slot> m_slots {}; // power of two, at most half full
+	size_t m_size = 0;
+	uint32_t intern(const std::string_view name);
+	size_t probe(const uint64_t hash) const;
+	void grow();
+	static void parse(Value & value, const std::string_view text);
+public:
+	Config() {};
+	~Config() {};
+	// Adds the value or replaces the one already there
+	void set(const std::string_view header, const std::string_view item, const std::string_view text);
+	// Replaces an existing value only; false when the key is unknown
+	bool assign(const ConfigKey key, const std::string_view text);
+	const Value * find(const ConfigKey key) const;
+	size_t size() const;
+	bool empty() const;
+	void clear();
+	// Every value, sorted by header then key (for export and printing)
+	std::vector<Entry> entries() const;
+};
@@ -0,0 +1,205 @@
+#include "config_cache.h"
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "config_parser.h"
+
+namespace {
+	const char magic[4] = {'G', 'W', 'C', 'F'};
+	// magic, version, mtime, size, hash, payload size
+	const size_t header_size = 4 + 4 + 8 + 8 + 8 + 8;
+
+	template <typename T>
+	void put(std::string & data, const T value) {
+		data.append(reinterpret_cast<const char *>(&value), sizeof(T));
+	}
+
+	void put_string(std::string & data, const std::string_view text) {
+		put(data, static_cast<uint32_t>(text.size()));
+		data.append(text);
+	}
+
+	// Bounds checked reads from a blob; ok turns false instead of reading past the end
+	struct Reader {
+		std::string_view data;
+		size_t pos {0};
+		bool ok {true};
+		template <typename T>
+		T get() {
+			T value {};
+			if (pos + sizeof(T) > data.size()) {
+				ok = false;
+				return value;
+			}
+			std::memcpy(&value, data.data() + pos, sizeof(T));
+			pos += sizeof(T);
+			return value;
+		}
+		std::string_view get_string() {
+			const uint32_t size = get<uint32_t>();
+			if (!ok || pos + size > data.size()) {
+				ok = false;
+				return {};
+			}
+			const std::string_view text = data.substr(pos, size);
+			pos += size;
+			return text;
+		}
+	};
+}
+
+ConfigCache::ConfigCache(const std::string & source)
+	: m_source(source)
+	, m_cache(source + ".cache")
+{}
+
+bool ConfigCache::hit() const {
+	return m_hit;
+}
+
+const std::string & ConfigCache::cache_file() const {
+	return m_cache;
+}
+
+bool ConfigCache::read_all(const std::string & filename, std::string & data) {
+	std::ifstream ifs(filename, std::ifstream::in | std::ifstream::binary);
+	if (!ifs) {
+		return false;
+	}
+	ifs.seekg(0, std::ifstream::end);
+	data.resize(static_cast<size_t>(ifs.tellg()));
+	ifs.seekg(0, std::ifstream::beg);
+	ifs.read(data.data(), data.size());
+	return static_cast<bool>(ifs);
+}
+
+ConfigCache::Stamp ConfigCache::stamp(const std::string & filename) {
+	Stamp result;
+	std::error_code error;
+	const auto mtime = std::filesystem::last_write_time(filename, error);
+	if (!error) {
+		result.mtime = mtime.time_since_epoch().count();
+	}
+	const uintmax_t size = std::filesystem::file_size(filename, error);
+	result.size = error ? 0 : size;
+	return result;
+}
+
+std::string ConfigCache::encode(const Config & config) {
+	const std::vector<Config::Entry> entries = config.entries();
+	// Sorted by header, so every header is one run of entries
+	std::vector<std::pair<size_t, size_t>> runs; // first entry, count
+	for (size_t i = 0; i < entries.size(); ++i) {
+		if (runs.empty() || entries[i].header != entries[runs.back().first].header) {
+			runs.push_back({i, 0});
+		}
+		++runs.back().second;
+	}
+	std::string payload;
+	put(payload, static_cast<uint32_t>(runs.size()));
+	for (const auto & [first, count] : runs) {
+		put_string(payload, entries[first].header);
+		put(payload, static_cast<uint32_t>(count));
+		for (size_t i = first; i < first + count; ++i) {
+			put_string(payload, entries[i].item);
+			put_string(payload, entries[i].value->text);
+		}
+	}
+	return payload;
+}
+
+bool ConfigCache::decode(const std::string_view payload, Config & config) {
+	Reader reader {payload};
+	const uint32_t header_count = reader.get<uint32_t>();
+	for (uint32_t h = 0; reader.ok && h < header_count; ++h) {
+		const std::string_view header = reader.get_string();
+		const uint32_t item_count = reader.get<uint32_t>();
+		for (uint32_t i = 0; reader.ok && i < item_count; ++i) {
+			const std::string_view key = reader.get_string();
+			const std::string_view value = reader.get_string();
+			if (reader.ok) {
+				config.set(header, key, value);
+			}
+		}
+	}
+	return reader.ok && reader.pos == payload.size();
+}
+
+void ConfigCache::write(const Config & config, const Stamp & stamp) const {
+	const std::string payload = encode(config);
+	std::string blob;
+	blob.reserve(header_size + payload.size() + 8);
+	blob.append(magic, sizeof(magic));
+	put(blob, version);
+	put(blob, stamp.mtime);
+	put(blob, stamp.size);
+	put(blob, stamp.hash);
+	put(blob, static_cast<uint64_t>(payload.size()));
+	blob.append(payload);
+	put(blob, fnv1a(payload));
+
+	// Write aside and rename, so a crash never leaves half a cache behind.
+	// A cache that can't be written (read only folder) is simply skipped.
+	const std::string temp = m_cache + ".tmp";
+	{
+		std::ofstream file(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file || !file.write(blob.data(), blob.size())) {
+			return;
+		}
+	}
+	std::error_code error;
+	std::filesystem::rename(temp, m_cache, error);
+	if (error) {
+		std::filesystem::remove(temp, error);
+	}
+}
+
+Config ConfigCache::load() {
+	m_hit = false;
+	Stamp current = stamp(m_source);
+
+	// Check the blob itself first: right format, intact payload
+	std::string blob;
+	Stamp cached;
+	std::string_view payload;
+	bool valid = read_all(m_cache, blob) && blob.size() >= header_size + 8
+		&& std::memcmp(blob.data(), magic, sizeof(magic)) == 0;
+	if (valid) {
+		Reader reader {blob, sizeof(magic)};
+		valid = reader.get<uint32_t>() == version;
+		cached.mtime = reader.get<int64_t>();
+		cached.size = reader.get<uint64_t>();
+		cached.hash = reader.get<uint64_t>();
+		const uint64_t payload_size = reader.get<uint64_t>();
+		valid = valid && payload_size == blob.size() - header_size - 8;
+		if (valid) {
+			payload = std::string_view(blob).substr(header_size, payload_size);
+			Reader tail {blob, header_size + payload_size};
+			valid = tail.get<uint64_t>() == fnv1a(payload);
+		}
+	}
+
+	Config config;
+	if (valid && cached.mtime == current.mtime && cached.size == current.size
+		&& decode(payload, config)) {
+		m_hit = true;
+		return config;
+	}
+
+	std::string text;
+	if (!read_all(m_source, text)) {
+		throw std::runtime_error("Could not read file");
+	}
+	current.hash = fnv1a(text);
+	// Touched but not changed: keep the payload, refresh the stamp
+	config.clear();
+	if (valid && cached.hash == current.hash && decode(payload, config)) {
+		m_hit = true;
+		write(config, current);
+		return config;
+	}
+	config = ConfigParser(text, m_source).parse();
+	write(config, current);
+	return config;
+}
@@ -0,0 +1,40 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include "config.h"
+
+// Keeps a compiled copy of a config text file next to it (<file>.cache)
+// so that startup reads one small blob instead of parsing text.
+// The text file stays the source of truth: the cache is only used while
+// the text file's modification time and size, or failing that the hash
+// of its contents, match what the cache was built from. Otherwise the
+// text is parsed and the cache rewritten.
+// Layout (native byte order, not meant to be shared between machines):
+//   "GWCF" | version | mtime | size | text hash | payload size | payload | checksum
+// payload: header count, then per header its name, item count and
+// key / value pairs; strings are a 32 bit length followed by the bytes.
+class ConfigCache {
+	struct Stamp {
+		int64_t mtime {0};
+		uint64_t size {0};
+		uint64_t hash {0};
+	};
+	std::string m_source;
+	std::string m_cache;
+	bool m_hit = false;
+	static bool read_all(const std::string & filename, std::string & data);
+	static Stamp stamp(const std::string & filename);
+	static std::string encode(const Config & config);
+	static bool decode(const std::string_view payload, Config & config);
+	void write(const Config & config, const Stamp & stamp) const;
+public:
+	static const uint32_t version = 1;
+	ConfigCache(const std::string & source);
+	~ConfigCache() {};
+	// Throws std::runtime_error when the text file can't be read or parsed
+	Config load();
+	// Whether the last load() was served from the cache
+	bool hit() const;
+	const std::string & cache_file() const;
+};
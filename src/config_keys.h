@@ -0,0 +1,123 @@
+#pragma once
+#include "config.h"
+
+// Names the code looks up, hashed at compile time.
+// Per power headers are a prefix plus the power:
+// config_header::shot_single + "2" names ShotSingle2.
+namespace config_header {
+	constexpr ConfigName global {"Global"};
+	constexpr ConfigName window {"Window"};
+	constexpr ConfigName font {"Font"};
+	constexpr ConfigName player {"Player"};
+	constexpr ConfigName enemy {"Enemy"};
+	constexpr ConfigName boss {"Boss"};
+	constexpr ConfigName pickup {"Pickup"};
+	constexpr ConfigName shot_single {"ShotSingle"};
+	constexpr ConfigName shot_spread {"ShotSpread"};
+	constexpr ConfigName shot_laser {"ShotLaser"};
+	constexpr ConfigName special_explosion {"SpecialExplosion"};
+	constexpr ConfigName special_rotor {"SpecialRotor"};
+	constexpr ConfigName special_flamethrower {"SpecialFlamethrower"};
+}
+
+namespace config_item {
+	constexpr ConfigName alpha_max {"alphaMax"};
+	constexpr ConfigName alpha_min {"alphaMin"};
+	constexpr ConfigName amount {"amount"};
+	constexpr ConfigName amount_types {"amountTypes"};
+	constexpr ConfigName angular_speed {"angularSpeed"};
+	constexpr ConfigName collision_radius {"collisionRadius"};
+	constexpr ConfigName duration {"duration"};
+	constexpr ConfigName fill_alpha {"fillAlpha"};
+	constexpr ConfigName fill_blue {"fillBlue"};
+	constexpr ConfigName fill_green {"fillGreen"};
+	constexpr ConfigName fill_green_max {"fillGreenMax"};
+	constexpr ConfigName fill_green_min {"fillGreenMin"};
+	constexpr ConfigName fill_red {"fillRed"};
+	constexpr ConfigName fill_red_max {"fillRedMax"};
+	constexpr ConfigName fill_red_min {"fillRedMin"};
+	constexpr ConfigName fire_rate {"fireRate"};
+	constexpr ConfigName freq {"freq"};
+	constexpr ConfigName invincibility_duration {"invincibilityDuration"};
+	constexpr ConfigName length {"length"};
+	constexpr ConfigName lifespan {"lifespan"};
+	constexpr ConfigName nozzle_spread {"nozzleSpread"};
+	constexpr ConfigName offset {"offset"};
+	constexpr ConfigName outline_alpha {"outlineAlpha"};
+	constexpr ConfigName outline_blue {"outlineBlue"};
+	constexpr ConfigName outline_green {"outlineGreen"};
+	constexpr ConfigName outline_red {"outlineRed"};
+	constexpr ConfigName outline_thickness {"outlineThickness"};
+	constexpr ConfigName quantity {"quantity"};
+	constexpr ConfigName radius {"radius"};
+	constexpr ConfigName radius_max {"radiusMax"};
+	constexpr ConfigName radius_min {"radiusMin"};
+	constexpr ConfigName random_scale {"randomScale"};
+	constexpr ConfigName recursion {"recursion"};
+	constexpr ConfigName score {"score"};
+	constexpr ConfigName score_size_multiplier {"scoreSizeMultiplier"};
+	constexpr ConfigName shape_radius {"shapeRadius"};
+	constexpr ConfigName small_amount {"smallAmount"};
+	constexpr ConfigName small_collision_radius {"smallCollisionRadius"};
+	constexpr ConfigName small_lifespan {"smallLifespan"};
+	constexpr ConfigName small_radius {"smallRadius"};
+	constexpr ConfigName small_score {"smallScore"};
+	constexpr ConfigName small_speed {"smallSpeed"};
+	constexpr ConfigName speed {"speed"};
+	constexpr ConfigName speed_max {"speedMax"};
+	constexpr ConfigName speed_min {"speedMin"};
+	constexpr ConfigName spread {"spread"};
+	constexpr ConfigName thickness {"thickness"};
+	constexpr ConfigName vert_size_multiplier {"vertSizeMultiplier"};
+	constexpr ConfigName vertices {"vertices"};
+	constexpr ConfigName vertices_max {"verticesMax"};
+	constexpr ConfigName vertices_min {"verticesMin"};
+	constexpr ConfigName verts_max {"vertsMax"};
+	constexpr ConfigName verts_min {"vertsMin"};
+}
+
+namespace config_key {
+	constexpr ConfigKey global_enemy_spawn_interval {"Global", "enemySpawnInterval"};
+	constexpr ConfigKey global_enemy_spawn_multiplier {"Global", "enemySpawnMultiplier"};
+	constexpr ConfigKey global_game_close_timeout {"Global", "gameCloseTimeout"};
+	constexpr ConfigKey global_max_power {"Global", "maxPower"};
+	constexpr ConfigKey global_seed {"Global", "seed"};
+	constexpr ConfigKey global_shape_rotation {"Global", "shapeRotation"};
+
+	constexpr ConfigKey window_width {"Window", "width"};
+	constexpr ConfigKey window_height {"Window", "height"};
+	constexpr ConfigKey window_depth {"Window", "depth"};
+	constexpr ConfigKey window_refresh_rate {"Window", "refreshRate"};
+	constexpr ConfigKey window_fullscreen {"Window", "fullscreen"};
+
+	constexpr ConfigKey font_path {"Font", "path"};
+	constexpr ConfigKey font_size {"Font", "size"};
+	constexpr ConfigKey font_red {"Font", "red"};
+	constexpr ConfigKey font_green {"Font", "green"};
+	constexpr ConfigKey font_blue {"Font", "blue"};
+
+	constexpr ConfigKey boss_score_requirement {"Boss", "scoreRequirement"};
+	constexpr ConfigKey boss_score_requirement_multiplier {"Boss", "scoreRequirementMultiplier"};
+
+	constexpr ConfigKey pickup_shape_radius {"Pickup", "shapeRadius"};
+	constexpr ConfigKey pickup_collision_radius {"Pickup", "collisionRadius"};
+	constexpr ConfigKey pickup_outline_thickness {"Pickup", "outlineThickness"};
+	constexpr ConfigKey pickup_vertices {"Pickup", "vertices"};
+	constexpr ConfigKey pickup_lifespan {"Pickup", "lifespan"};
+
+	constexpr ConfigKey player_shape_radius {"Player", "shapeRadius"};
+	constexpr ConfigKey player_collision_radius {"Player", "collisionRadius"};
+	constexpr ConfigKey player_speed {"Player", "speed"};
+	constexpr ConfigKey player_invincibility_duration {"Player", "invincibilityDuration"};
+	constexpr ConfigKey player_flicker_rate {"Player", "flickerRate"};
+	constexpr ConfigKey player_fill_red {"Player", "fillRed"};
+	constexpr ConfigKey player_fill_green {"Player", "fillGreen"};
+	constexpr ConfigKey player_fill_blue {"Player", "fillBlue"};
+	constexpr ConfigKey player_outline_red {"Player", "outlineRed"};
+	constexpr ConfigKey player_outline_green {"Player", "outlineGreen"};
+	constexpr ConfigKey player_outline_blue {"Player", "outlineBlue"};
+	constexpr ConfigKey player_outline_thickness {"Player", "outlineThickness"};
+	constexpr ConfigKey player_vertices {"Player", "vertices"};
+	constexpr ConfigKey player_health {"Player", "health"};
+	constexpr ConfigKey player_spawn_interval {"Player", "spawnInterval"};
+}
@@ -0,0 +1,95 @@
+#include "config_parser.h"
+#include <stdexcept>
+
+namespace {
+	bool is_space(const char c) {
+		return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '\f' || c == '\v';
+	}
+}
+
+ConfigParser::ConfigParser(const std::string_view text, const std::string & source)
+	: m_text(text)
+	, m_source(source)
+{}
+
+bool ConfigParser::at_end() const {
+	return m_pos >= m_text.size();
+}
+
+char ConfigParser::peek() const {
+	return m_text[m_pos];
+}
+
+void ConfigParser::skip_separators() {
+	while (!at_end() && (is_space(peek()) || peek() == ',')) {
+		if (peek() == '\n') {
+			++m_line;
+			m_line_start = m_pos + 1;
+		}
+		++m_pos;
+	}
+}
+
+void ConfigParser::skip_blanks() {
+	while (!at_end() && (peek() == ' ' || peek() == '\t')) {
+		++m_pos;
+	}
+}
+
+std::string_view ConfigParser::read_word(const std::string_view stop) {
+	const size_t begin = m_pos;
+	while (!at_end() && !is_space(peek()) && stop.find(peek()) == std::string_view::npos) {
+		++m_pos;
+	}
+	return m_text.substr(begin, m_pos - begin);
+}
+
+void ConfigParser::expect(const char c, const std::string & what) {
+	if (at_end() || peek() != c) {
+		fail("expected '" + std::string(1, c) + "' " + what);
+	}
+	++m_pos;
+}
+
+void ConfigParser::fail(const std::string & message) const {
+	const size_t column = m_pos - m_line_start + 1;
+	throw std::runtime_error(m_source + ":" + std::to_string(m_line) + ":"
+		+ std::to_string(column) + ": " + message);
+}
+
+Config ConfigParser::parse() {
+	Config config;
+	skip_separators();
+	while (!at_end()) {
+		const std::string_view header = read_word("[]=,");
+		if (header.empty()) {
+			fail("expected a header");
+		}
+		skip_separators();
+		expect('[', "after header " + std::string(header));
+		while (true) {
+			skip_separators();
+			if (at_end()) {
+				fail("missing ']' to close header " + std::string(header));
+			}
+			if (peek() == ']') {
+				++m_pos;
+				break;
+			}
+			const std::string_view key = read_word("[]=,");
+			if (key.empty()) {
+				fail("expected a key");
+			}
+			skip_blanks();
+			expect('=', "after key " + std::string(key));
+			skip_blanks();
+			const std::string_view value = read_word("],");
+			if (value.empty()) {
+				fail("expected a value for key " + std::string(key));
+			}
+			config.set(header, key, value);
+		}
+		skip_separators();
+	}
+	return config;
+}
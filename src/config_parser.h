@@ -0,0 +1,31 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include "config.h"
+
+// Builds a Config in a single pass over the whole file contents.
+// Headers, keys and values stay string_views into the text until they are
+// stored, and errors name the line and column they were found at.
+//   Header [
+//     key=value,
+//   ],
+// Commas are optional and whitespace may appear anywhere between tokens.
+class ConfigParser {
+	std::string_view m_text;
+	std::string m_source;
+	size_t m_pos = 0;
+	size_t m_line = 1;
+	size_t m_line_start = 0;
+	bool at_end() const;
+	char peek() const;
+	void skip_separators();
+	void skip_blanks();
+	std::string_view read_word(const std::string_view stop);
+	void expect(const char c, const std::string & what);
+	[[noreturn]] void fail(const std::string & message) const;
+public:
+	ConfigParser(const std::string_view text, const std::string & source);
+	~ConfigParser() {};
+	// Throws std::runtime_error ("source:line:column: message") on bad input
+	Config parse();
+};
@@ -0,0 +1,226 @@
+#include "config_watcher.h"
+#include <chrono>
+#include <algorithm>
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+#include "trace.h"
+#ifdef __linux__
+#include <cerrno>
+#include <poll.h>
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+ConfigWatcher::~ConfigWatcher() {
+	stop();
+}
+
+void ConfigWatcher::start(const std::string & path, const Config & reference, Parser parse) {
+	stop();
+	m_path = path;
+	m_reference = reference;
+	m_parse = parse;
+	// The file was just loaded, so its current state is not a change
+	m_stamp = stamp(path);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending.reset();
+		m_error.clear();
+		m_expected.clear();
+		m_running = true;
+	}
+	m_thread = std::thread(&ConfigWatcher::run, this);
+}
+
+void ConfigWatcher::stop() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_running = false;
+	}
+	m_cv.notify_all();
+	if (m_thread.joinable()) {
+		m_thread.join();
+	}
+}
+
+std::unique_ptr<Config> ConfigWatcher::take() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return std::move(m_pending);
+}
+
+std::string ConfigWatcher::error() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_error;
+}
+
+size_t ConfigWatcher::reloads() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_reloads;
+}
+
+void ConfigWatcher::expect_write(const std::string & text) {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_expected.push_back(fnv1a(text));
+}
+
+bool ConfigWatcher::expected(const std::string & path) {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		if (m_expected.empty()) {
+			return false;
+		}
+	}
+	std::ifstream file(path, std::ios::binary);
+	std::stringstream text;
+	text << file.rdbuf();
+	const uint64_t hash = fnv1a(text.str());
+	std::lock_guard<std::mutex> lock(m_mutex);
+	const auto found = std::find(m_expected.begin(), m_expected.end(), hash);
+	if (found == m_expected.end()) {
+		return false;
+	}
+	m_expected.erase(found);
+	return true;
+}
+
+bool ConfigWatcher::uses_inotify() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_inotify;
+}
+
+const std::string & ConfigWatcher::path() const {
+	return m_path;
+}
+
+bool ConfigWatcher::running() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_running;
+}
+
+void ConfigWatcher::run() {
+	Trace::set_thread_name("Config watcher");
+	if (!watch_inotify()) {
+		watch_mtime();
+	}
+}
+
+ConfigWatcher::FileStamp ConfigWatcher::stamp(const std::string & path) {
+	std::error_code error;
+	FileStamp result;
+	const auto mtime = std::filesystem::last_write_time(path, error);
+	if (error) {
+		return result;
+	}
+	result.mtime = mtime.time_since_epoch().count();
+	const uintmax_t size = std::filesystem::file_size(path, error);
+	result.size = error ? 0 : size;
+	return result;
+}
+
+void ConfigWatcher::reload() {
+	// Events also fire for writes that leave the file as it was
+	const FileStamp current = stamp(m_path);
+	if (current == m_stamp) {
+		return;
+	}
+	m_stamp = current;
+	// Saved from the GUI, matched by content as the write may finish
+	// before or after the game hears about it
+	if (expected(m_path)) {
+		return;
+	}
+	TRACE_SCOPE("Config reload");
+	std::unique_ptr<Config> config;
+	std::string error;
+	try {
+		config = std::make_unique<Config>(m_parse(m_path));
+		error = validate(m_reference, *config);
+	} catch (std::exception & e) {
+		error = e.what();
+	}
+	std::lock_guard<std::mutex> lock(m_mutex);
+	if (!error.empty()) {
+		m_error = error;
+		return;
+	}
+	m_error.clear();
+	m_pending = std::move(config);
+	++m_reloads;
+}
+
+bool ConfigWatcher::watch_inotify() {
+#ifdef __linux__
+	// Watch the directory: editors often save by renaming a new file over
+	// the old one, which would drop a watch on the file itself
+	const std::filesystem::path file(m_path);
+	const std::string name = file.filename().string();
+	const std::string directory = file.has_parent_path() ? file.parent_path().string() : ".";
+	const int fd = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+	if (fd < 0) {
+		return false;
+	}
+	if (inotify_add_watch(fd, directory.c_str(), IN_CLOSE_WRITE | IN_MOVED_TO) < 0) {
+		close(fd);
+		return false;
+	}
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_inotify = true;
+	}
+	alignas(inotify_event) char buffer[4096];
+	pollfd descriptor {fd, POLLIN, 0};
+	while (running()) {
+		// Time out now and then to notice stop()
+		if (poll(&descriptor, 1, 250) <= 0) {
+			continue;
+		}
+		bool changed = false;
+		ssize_t length;
+		while ((length = read(fd, buffer, sizeof(buffer))) > 0) {
+			for (char * it = buffer; it < buffer + length;) {
+				const inotify_event * event = reinterpret_cast<const inotify_event *>(it);
+				if (event->len > 0 && name == event->name) {
+					changed = true;
+				}
+				it += sizeof(inotify_event) + event->len;
+			}
+		}
+		if (changed) {
+			reload();
+		}
+	}
+	close(fd);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void ConfigWatcher::watch_mtime() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_inotify = false;
+	while (m_running) {
+		m_cv.wait_for(lock, std::chrono::milliseconds(500), [this] { return !m_running; });
+		if (!m_running) {
+			break;
+		}
+		lock.unlock();
+		reload();
+		lock.lock();
+	}
+}
+
+std::string ConfigWatcher::validate(const Config & reference, const Config & config) {
+	for (const Config::Entry & entry : reference.entries()) {
+		const Config::Value * value = config.find(ConfigKey(entry.header, entry.item));
+		const std::string name = std::string(entry.header) + ":" + std::string(entry.item);
+		if (!value) {
+			return "Missing config item: " + name;
+		}
+		if (entry.value->type != Config::String && value->type == Config::String) {
+			return "Not a number: " + name + "=" + value->text;
+		}
+	}
+	return "";
+}
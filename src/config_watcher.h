@@ -0,0 +1,65 @@
+#pragma once
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include "config.h"
+
+// Watches one config file on a thread of its own (inotify on Linux,
+// modification time polling elsewhere). When the file really changed it
+// is parsed and validated on that thread; the result waits in take()
+// until the game swaps it in between two frames. take() only ever waits
+// for a pointer swap, never for a parse.
+class ConfigWatcher {
+public:
+	typedef std::function<Config(const std::string &)> Parser;
+private:
+	struct FileStamp {
+		int64_t mtime {0};
+		uintmax_t size {0};
+		bool operator==(const FileStamp & other) const = default;
+	};
+	std::string m_path {};
+	Parser m_parse {};
+	Config m_reference {};
+	FileStamp m_stamp {};
+	std::thread m_thread {};
+	std::mutex m_mutex {};
+	std::condition_variable m_cv {};
+	bool m_running = false;
+	// Guarded by m_mutex
+	std::unique_ptr<Config> m_pending {};
+	std::string m_error {};
+	size_t m_reloads = 0;
+	bool m_inotify = false;
+	std::vector<uint64_t> m_expected {}; // hashes of the game's own writes
+	bool running();
+	void run();
+	bool watch_inotify();
+	void watch_mtime();
+	void reload();
+	bool expected(const std::string & path);
+	static FileStamp stamp(const std::string & path);
+public:
+	ConfigWatcher() {};
+	~ConfigWatcher();
+	// reference holds every header and key a new config has to provide
+	void start(const std::string & path, const Config & reference, Parser parse);
+	void stop();
+	// The newest valid config since the last call, or nullptr
+	std::unique_ptr<Config> take();
+	// Why the last change was rejected, empty once a reload succeeded
+	std::string error();
+	size_t reloads();
+	bool uses_inotify();
+	const std::string & path() const;
+	// The game is about to write text to the watched file itself; that
+	// change is already in memory, so it is not reloaded
+	void expect_write(const std::string & text);
+	// Empty when config has every key of reference and numbers stay numbers
+	static std::string validate(const Config & reference, const Config & config);
+};
@@ -0,0 +1,149 @@
+#include "config_writer.h"
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+#include "trace.h"
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <unistd.h>
+#endif
+
+ConfigWriter::~ConfigWriter() {
+	stop();
+}
+
+void ConfigWriter::start(WriteHook before_write) {
+	stop();
+	m_before_write = before_write;
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_running = true;
+	}
+	m_thread = std::thread(&ConfigWriter::run, this);
+}
+
+void ConfigWriter::stop() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_running = false;
+	}
+	m_cv.notify_all();
+	if (m_thread.joinable()) {
+		m_thread.join();
+	}
+}
+
+void ConfigWriter::save(const Config & config, const std::string & filename) {
+	std::unique_ptr<Config> snapshot = std::make_unique<Config>(config);
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending = std::move(snapshot);
+		m_pending_file = filename;
+	}
+	m_cv.notify_all();
+}
+
+size_t ConfigWriter::saves() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_saves;
+}
+
+std::string ConfigWriter::error() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_error;
+}
+
+void ConfigWriter::run() {
+	Trace::set_thread_name("Config writer");
+	std::unique_lock<std::mutex> lock(m_mutex);
+	while (true) {
+		m_cv.wait(lock, [this] { return m_pending || !m_running; });
+		if (!m_pending) {
+			break;
+		}
+		std::unique_ptr<Config> config = std::move(m_pending);
+		const std::string filename = m_pending_file;
+		lock.unlock();
+		std::string error;
+		try {
+			TRACE_SCOPE("Config save");
+			const std::string text = format(*config);
+			if (m_before_write) {
+				m_before_write(filename, text);
+			}
+			write_atomic(text, filename);
+		} catch (std::exception & e) {
+			error = e.what();
+		}
+		lock.lock();
+		m_error = error;
+		if (error.empty()) {
+			++m_saves;
+		}
+	}
+}
+
+std::string ConfigWriter::format(const Config & config) {
+	std::string text;
+	std::string_view heading;
+	for (const Config::Entry & entry : config.entries()) {
+		if (entry.header != heading) {
+			if (!heading.empty()) {
+				text += "],\n";
+			}
+			heading = entry.header;
+			text.append(heading).append(" [\n");
+		}
+		text.append("\t").append(entry.item).append("=").append(entry.value->text).append(",\n");
+	}
+	if (!heading.empty()) {
+		text += "],\n";
+	}
+	return text;
+}
+
+void ConfigWriter::write_atomic(const std::string & text, const std::string & filename) {
+	const std::string temp = filename + ".tmp";
+#if defined(__unix__) || defined(__APPLE__)
+	const int fd = ::open(temp.c_str(), O_WRONLY | O_CREAT | O_TRUNC | O_CLOEXEC, 0644);
+	if (fd < 0) {
+		throw std::runtime_error("Could not create file: " + temp);
+	}
+	size_t written = 0;
+	while (written < text.size()) {
+		const ssize_t result = ::write(fd, text.data() + written, text.size() - written);
+		if (result < 0) {
+			::close(fd);
+			throw std::runtime_error("Could not write file: " + temp);
+		}
+		written += static_cast<size_t>(result);
+	}
+	if (::fsync(fd) != 0) {
+		::close(fd);
+		throw std::runtime_error("Could not flush file: " + temp);
+	}
+	::close(fd);
+#else
+	{
+		std::ofstream file(temp, std::ios::out | std::ios::binary | std::ios::trunc);
+		if (!file || !file.write(text.data(), text.size()) || !file.flush()) {
+			throw std::runtime_error("Could not write file: " + temp);
+		}
+	}
+#endif
+	std::error_code error;
+	std::filesystem::rename(temp, filename, error);
+	if (error) {
+		std::filesystem::remove(temp, error);
+		throw std::runtime_error("Could not replace file: " + filename);
+	}
+#if defined(__unix__) || defined(__APPLE__)
+	// Make the rename itself durable
+	const std::filesystem::path parent = std::filesystem::path(filename).parent_path();
+	const int dir = ::open(parent.empty() ? "." : parent.c_str(), O_RDONLY | O_CLOEXEC);
+	if (dir >= 0) {
+		::fsync(dir);
+		::close(dir);
+	}
+#endif
+}
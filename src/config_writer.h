@@ -0,0 +1,45 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include "config.h"
+
+// Saves config snapshots on a thread of its own, so a slow disk never
+// holds up a frame. Each file is written next to its target, flushed to
+// disk and renamed over it: readers (and the config watcher) only ever
+// see the old file or the complete new one. When saves pile up only the
+// newest snapshot is written; stop() still writes a pending one.
+class ConfigWriter {
+public:
+	// Called on the writer thread with each file just before it is written
+	typedef std::function<void(const std::string & filename, const std::string & text)> WriteHook;
+private:
+	std::thread m_thread {};
+	WriteHook m_before_write {};
+	std::mutex m_mutex {};
+	std::condition_variable m_cv {};
+	bool m_running = false;
+	std::unique_ptr<Config> m_pending {};
+	std::string m_pending_file {};
+	size_t m_saves = 0;
+	std::string m_error {};
+	void run();
+public:
+	ConfigWriter() {};
+	~ConfigWriter();
+	void start(WriteHook before_write = {});
+	void stop();
+	// Copies config; the file is written later
+	void save(const Config & config, const std::string & filename);
+	// Completed saves so far
+	size_t saves();
+	// Why the last save failed, empty once one succeeded
+	std::string error();
+	// The config.txt text of config
+	static std::string format(const Config & config);
+	// Temp file, flush to disk, rename. Throws std::runtime_error
+	static void write_atomic(const std::string & text, const std::string & filename);
+};
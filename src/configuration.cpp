@@ -1,171 +1,316 @@
 #include "game.h"
-#include <fstream>
+#include "config_cache.h"
+#include "config_keys.h"
+#include <cmath>
 
 void Game::test_config(Config &config) const {
-  std::for_each(
-      config.begin(), config.end(),
-      [](std::pair<std::string, std::map<std::string, std::string>> p) {
-        std::cout << "Heading: " << p.first << '\n';
-        std::for_each(p.second.begin(), p.second.end(),
-                      [](std::pair<std::string, std::string> v) {
-                        std::cout << v.first << ": " << v.second << '\n';
-                      });
-      });
-  std::cout << "====Individual tests====\n";
-  std::cout << "Window resolution and refresh rate: "
-            << config["Window"]["width"] << "x" << config["Window"]["height"]
-            << ", " << config["Window"]["refreshRate"] << '\n';
-}
-
-Config Game::parse_tokens(const std::vector<std::string> &tokenstream) const {
-  bool nextHeading = true;
-  std::string heading = "";
-  Config config;
-  for (std::string token : tokenstream) {
-
-    std::string key, value;
-    std::string::size_type begin = token.find_first_not_of(" ,[\f\t\v");
-
-    if (nextHeading) {
-      nextHeading = false;
-      heading = token;
-      config[heading] = {};
-      // std::cout << "Heading: " << heading << "\n";
-      continue;
-    }
-
-    if (token.find(']') != std::string::npos) {
-      nextHeading = true;
-      // std::cout << "next heading\n";
-    }
-
-    // Skip blank lines
-    if (begin == std::string::npos) {
-      continue;
-    }
-
-    // Extract the key value
-    std::string::size_type end = token.find('=', begin);
-    key = token.substr(begin, end - begin);
-
-    // (No leading or trailing whitespace allowed)
-    key.erase(key.find_last_not_of(" ,]\f\t\v") + 1);
-
-    // No blank keys allowed
-    if (key.empty()) {
-      continue;
+  std::string_view heading;
+  for (const Config::Entry &entry : config.entries()) {
+    if (entry.header != heading) {
+      heading = entry.header;
+      std::cout << "Heading: " << heading << '\n';
     }
-
-    // Extract the value (no leading or trailing whitespace allowed)
-    begin = token.find_first_not_of(" ,]\f\n\r\t\v", end + 1);
-    end = token.find_last_not_of(" ,]\f\n\r\t\v") + 1;
-
-    value = token.substr(begin, end - begin);
-
-    // std::cout << "key: " << key << ", value: " << value << '\n';
-    config[heading][key] = value;
+    std::cout << entry.item << ": " << entry.value->text << '\n';
   }
-  return config;
+  const auto text = [&](const ConfigKey &key) {
+    const Config::Value *value = config.find(key);
+    return value ? value->text : "";
+  };
+  std::cout << "====Individual tests====\n";
+  std::cout << "Window resolution and refresh rate: "
+            << text(config_key::window_width) << "x"
+            << text(config_key::window_height) << ", "
+            << text(config_key::window_refresh_rate) << '\n';
 }
 
 const Config Game::read_file(const std::string &filename) const {
   // May throw, should be enclosed in try / catch expression
-  std::vector<std::string> tokenstream{};
-  std::string word;
+  // Goes through the compiled <filename>.cache while the text is unchanged
+  return ConfigCache(filename).load();
+}
 
-  std::ifstream ifs(filename, std::ifstream::in);
-  if (!ifs) {
-    throw std::runtime_error("Could not read file");
-  }
-  while (ifs >> word) {
-    tokenstream.push_back(word);
+const int Game::read_config_i(const ConfigKey &key) const {
+  const Config::Value *value = m_config.find(key);
+  if (!value || value->type == Config::String) {
+    std::cerr << "Invalid argument: "
+              << (value ? value->text : "missing config item") << std::endl;
+    return -1;
   }
-
-  return parse_tokens(tokenstream);
+  return value->i;
 }
 
 const int Game::read_config_i(const std::string &header,
-                              const std::string &value) {
-  try {
-    return std::stoi(m_config[header][value]);
-  } catch (const std::invalid_argument &ia) {
-    std::cerr << "Invalid argument: " << ia.what() << " | " << header << ":"
-              << value << std::endl;
+                              const std::string &value) const {
+  if (!m_config.find({header, value})) {
+    std::cerr << "Missing config item: " << header << ":" << value
+              << std::endl;
     return -1;
   }
+  return read_config_i(ConfigKey(header, value));
+}
 
-  catch (const std::out_of_range &oor) {
-    std::cerr << "Out of Range error: " << oor.what() << std::endl;
-    return -2;
-  }
-
-  catch (const std::exception &e) {
-    std::cerr << "Undefined error: " << e.what() << std::endl;
-    return -3;
+const float Game::read_config_f(const ConfigKey &key) const {
+  const Config::Value *value = m_config.find(key);
+  if (!value || value->type == Config::String) {
+    std::cerr << "Invalid argument: "
+              << (value ? value->text : "missing config item") << std::endl;
+    return -1;
   }
+  return value->f;
 }
 
 const float Game::read_config_f(const std::string &header,
-                                const std::string &value) {
-  try {
-    return std::stof(m_config[header][value]);
-  } catch (const std::invalid_argument &ia) {
-    std::cerr << "Invalid argument: " << ia.what() << " | " << header << ":"
-              << value << std::endl;
+                                const std::string &value) const {
+  if (!m_config.find({header, value})) {
+    std::cerr << "Missing config item: " << header << ":" << value
+              << std::endl;
     return -1;
   }
+  return read_config_f(ConfigKey(header, value));
+}
 
-  catch (const std::out_of_range &oor) {
-    std::cerr << "Out of Range error: " << oor.what() << std::endl;
-    return -2;
-  }
+const std::string Game::read_config_s(const ConfigKey &key) const {
+  const Config::Value *value = m_config.find(key);
+  return value ? value->text : "";
+}
+
+const std::string Game::read_config_s(const std::string &header,
+                                      const std::string &value) const {
+  return read_config_s(ConfigKey(header, value));
+}
 
-  catch (const std::exception &e) {
-    std::cerr << "Undefined error: " << e.what() << std::endl;
-    return -3;
+void Game::write_config(const ConfigKey &key, const std::string &value) {
+  // A single table store; the parameter tables are rebuilt once per frame
+  if (!m_config.assign(key, value)) {
+    throw std::runtime_error("Wrong config item: " + value);
   }
+  m_params_dirty = true;
 }
 
 void Game::write_config(const std::string &header, const std::string &item,
                         const std::string &value) {
-  if (m_config[header][item].size() == 0) {
+  if (!m_config.assign({header, item}, value)) {
     throw std::runtime_error("Wrong config item: " + header + ":" + item);
-  } else {
-    m_config[header][item] = value;
-  }
-}
-
-const std::string Game::read_config_s(const std::string &header,
-                                      const std::string &value) {
-  try {
-    return m_config[header][value];
-  } catch (std::exception &e) {
-    throw std::runtime_error(std::string(e.what(), sizeof(e.what())) +
-                             " | Config string read error: " + header + value);
   }
+  m_params_dirty = true;
 }
 
 void Game::export_config(Config &config, const std::string &filename) const {
   // May throw, should be enclosed in try / catch expression
+  // Blocks until the file is on disk; the GUI saves through m_config_writer
+  ConfigWriter::write_atomic(ConfigWriter::format(config), filename);
+}
 
-  std::ofstream file;
-  file.open(filename, std::ios::out);
-  if (!file) {
-    throw std::runtime_error("Could not create file");
+void Game::apply_config(const Config &config) {
+  // Everything read on the fly picks the new values up by itself; window
+  // and font settings still need a restart
+  const int old_enemy_interval =
+      read_config_i(config_key::global_enemy_spawn_interval);
+  const int old_player_interval =
+      read_config_i(config_key::player_spawn_interval);
+  const int old_score_to_boss = m_params.boss.score_requirement;
+  m_config = config;
+  compile_params();
+  m_game_close_timeout = read_config_i(config_key::global_game_close_timeout);
+  // The live values have moved on since the start of the run (boss kills,
+  // GUI edits), so they only follow a change of their base value
+  const auto rescale = [](const auto live, const auto old_base,
+                          const auto new_base) {
+    if (old_base == new_base) {
+      return live;
+    }
+    if (old_base <= 0) {
+      return new_base;
+    }
+    return (decltype(live))std::round((double)live * new_base / old_base);
+  };
+  m_enemy_spawn_interval =
+      rescale(m_enemy_spawn_interval, old_enemy_interval,
+              read_config_i(config_key::global_enemy_spawn_interval));
+  m_player_spawn_interval =
+      rescale(m_player_spawn_interval, old_player_interval,
+              read_config_i(config_key::player_spawn_interval));
+  m_score_to_boss_base =
+      rescale(m_score_to_boss_base, (size_t)old_score_to_boss,
+              (size_t)m_params.boss.score_requirement);
+  m_score_to_boss_mult = m_params.boss.score_requirement_multiplier;
+  m_shape_rotation = read_config_f(config_key::global_shape_rotation);
+}
+
+void Game::compile_params() {
+  namespace item = config_item;
+  GameParams params;
+  params.max_power = read_config_i(config_key::global_max_power);
+  params.enemy_spawn_multiplier =
+      read_config_f(config_key::global_enemy_spawn_multiplier);
+
+  const auto read_i = [&](const ConfigName header, const ConfigName name) {
+    return read_config_i(ConfigKey(header, name));
+  };
+  const auto read_f = [&](const ConfigName header, const ConfigName name) {
+    return read_config_f(ConfigKey(header, name));
+  };
+  const auto read_color = [&](const ConfigName header, const ConfigName red,
+                              const ConfigName green, const ConfigName blue) {
+    return sf::Color(read_i(header, red), read_i(header, green),
+                     read_i(header, blue));
+  };
+  const auto read_bullet = [&](const ConfigName header) {
+    return CShape(read_f(header, item::shape_radius),
+                  read_i(header, item::vertices),
+                  read_color(header, item::fill_red, item::fill_green,
+                             item::fill_blue),
+                  read_color(header, item::outline_red, item::outline_green,
+                             item::outline_blue),
+                  read_i(header, item::outline_thickness));
+  };
+  const auto read_shot = [&](const ConfigName header, const bool spread) {
+    ShotParams shot;
+    shot.speed = read_f(header, item::speed);
+    if (spread) {
+      shot.spread = read_f(header, item::spread);
+      shot.amount = read_i(header, item::amount);
+    }
+    shot.fire_rate = read_i(header, item::fire_rate);
+    shot.lifespan = read_i(header, item::lifespan);
+    shot.collision_radius = read_f(header, item::collision_radius);
+    shot.bullet = read_bullet(header);
+    return shot;
+  };
+
+  WeaponParams &weapons = params.weapons;
+  for (int power = 0; power <= params.max_power; ++power) {
+    const std::string p = std::to_string(power);
+    weapons.shot_single.push_back(
+        read_shot(config_header::shot_single + p, false));
+    weapons.shot_spread.push_back(
+        read_shot(config_header::shot_spread + p, true));
+
+    const ConfigName laser_header = config_header::shot_laser + p;
+    LaserParams laser;
+    laser.fire_rate = read_i(laser_header, item::fire_rate);
+    laser.lifespan = read_i(laser_header, item::lifespan);
+    laser.offset = read_f(laser_header, item::offset);
+    laser.length = read_f(laser_header, item::length);
+    laser.thickness = read_f(laser_header, item::thickness);
+    laser.fill_color = read_color(laser_header, item::fill_red,
+                                  item::fill_green, item::fill_blue);
+    laser.fill_color.a = read_i(laser_header, item::fill_alpha);
+    laser.outline_color = read_color(laser_header, item::outline_red,
+                                     item::outline_green, item::outline_blue);
+    laser.outline_color.a = read_i(laser_header, item::outline_alpha);
+    laser.outline_thickness = read_i(laser_header, item::outline_thickness);
+    weapons.shot_laser.push_back(laser);
+
+    const ConfigName explosion_header = config_header::special_explosion + p;
+    ExplosionParams explosion;
+    explosion.fire_rate = read_i(explosion_header, item::fire_rate);
+    explosion.lifespan = read_i(explosion_header, item::lifespan);
+    explosion.small_lifespan = read_i(explosion_header, item::small_lifespan);
+    explosion.speed = read_i(explosion_header, item::speed);
+    explosion.small_speed = read_i(explosion_header, item::small_speed);
+    explosion.small_amount = read_i(explosion_header, item::small_amount);
+    explosion.recursion = read_i(explosion_header, item::recursion);
+    explosion.collision_radius =
+        read_f(explosion_header, item::collision_radius);
+    explosion.bullet = read_bullet(explosion_header);
+    weapons.special_explosion.push_back(explosion);
+
+    const ConfigName rotor_header = config_header::special_rotor + p;
+    RotorParams rotor;
+    rotor.angular_speed = read_f(rotor_header, item::angular_speed);
+    rotor.amount = read_i(rotor_header, item::amount);
+    rotor.radius = read_f(rotor_header, item::radius);
+    rotor.fire_rate = read_i(rotor_header, item::fire_rate);
+    rotor.lifespan = read_i(rotor_header, item::lifespan);
+    rotor.collision_radius = read_f(rotor_header, item::collision_radius);
+    rotor.bullet = read_bullet(rotor_header);
+    weapons.special_rotor.push_back(rotor);
+
+    const ConfigName flame_header = config_header::special_flamethrower + p;
+    FlamethrowerParams flame;
+    flame.spread = read_f(flame_header, item::spread);
+    flame.nozzle_spread = read_f(flame_header, item::nozzle_spread);
+    flame.speed = read_i(flame_header, item::speed);
+    flame.duration = read_i(flame_header, item::duration);
+    flame.fire_rate = read_i(flame_header, item::fire_rate);
+    flame.offset = read_f(flame_header, item::offset);
+    flame.freq = read_i(flame_header, item::freq);
+    flame.quantity = read_i(flame_header, item::quantity);
+    flame.small_lifespan = read_i(flame_header, item::small_lifespan);
+    flame.random_scale = read_f(flame_header, item::random_scale);
+    flame.fill_red_min = read_i(flame_header, item::fill_red_min);
+    flame.fill_red_max = read_i(flame_header, item::fill_red_max);
+    flame.fill_green_min = read_i(flame_header, item::fill_green_min);
+    flame.fill_green_max = read_i(flame_header, item::fill_green_max);
+    flame.fill_blue = read_i(flame_header, item::fill_blue);
+    flame.alpha_min = read_i(flame_header, item::alpha_min);
+    flame.alpha_max = read_i(flame_header, item::alpha_max);
+    flame.radius_min = read_i(flame_header, item::radius_min);
+    flame.radius_max = read_i(flame_header, item::radius_max);
+    flame.verts_min = read_i(flame_header, item::verts_min);
+    flame.verts_max = read_i(flame_header, item::verts_max);
+    flame.amount_types = read_i(flame_header, item::amount_types);
+    weapons.special_flamethrower.push_back(flame);
   }
 
-  // file << "something";
+  const auto read_enemy = [&](const ConfigName header, EnemyParams &enemy) {
+    enemy.shape_radius = read_f(header, item::shape_radius);
+    enemy.collision_radius = read_f(header, item::collision_radius);
+    enemy.speed_min = read_f(header, item::speed_min);
+    enemy.speed_max = read_f(header, item::speed_max);
+    enemy.outline_color = read_color(header, item::outline_red,
+                                     item::outline_green, item::outline_blue);
+    enemy.outline_thickness = read_i(header, item::outline_thickness);
+    enemy.vertices_min = read_i(header, item::vertices_min);
+    enemy.vertices_max = read_i(header, item::vertices_max);
+    enemy.vert_size_multiplier = read_f(header, item::vert_size_multiplier);
+    enemy.small_radius = read_f(header, item::small_radius);
+    enemy.small_collision_radius =
+        read_f(header, item::small_collision_radius);
+    enemy.small_speed = read_f(header, item::small_speed);
+    enemy.small_lifespan = read_i(header, item::small_lifespan);
+    enemy.small_score = read_i(header, item::small_score);
+    enemy.invincibility_duration =
+        read_i(header, item::invincibility_duration);
+    enemy.score = read_i(header, item::score);
+    enemy.score_size_multiplier = read_f(header, item::score_size_multiplier);
+  };
+  read_enemy(config_header::enemy, params.enemy);
+  read_enemy(config_header::boss, params.boss);
+  params.boss.score_requirement =
+      read_config_i(config_key::boss_score_requirement);
+  params.boss.score_requirement_multiplier =
+      read_config_f(config_key::boss_score_requirement_multiplier);
+
+  params.pickup.shape_radius = read_config_f(config_key::pickup_shape_radius);
+  params.pickup.collision_radius =
+      read_config_f(config_key::pickup_collision_radius);
+  params.pickup.outline_thickness =
+      read_config_i(config_key::pickup_outline_thickness);
+  params.pickup.vertices = read_config_i(config_key::pickup_vertices);
+  params.pickup.lifespan = read_config_i(config_key::pickup_lifespan);
 
-  std::for_each(
-      config.begin(), config.end(),
-      [&](std::pair<std::string, std::map<std::string, std::string>> p) {
-        file << p.first << " [\n";
-        std::for_each(p.second.begin(), p.second.end(),
-                      [&](std::pair<std::string, std::string> v) {
-                        file << '\t' << v.first << "=" << v.second << ",\n";
-                      });
-        file << "],\n";
-      });
+  params.player.shape_radius = read_config_f(config_key::player_shape_radius);
+  params.player.collision_radius =
+      read_config_f(config_key::player_collision_radius);
+  params.player.speed = read_config_f(config_key::player_speed);
+  params.player.invincibility_duration =
+      read_config_i(config_key::player_invincibility_duration);
+  params.player.flicker_rate = read_config_i(config_key::player_flicker_rate);
+  params.player.fill_color = sf::Color(read_config_i(config_key::player_fill_red),
+                                       read_config_i(config_key::player_fill_green),
+                                       read_config_i(config_key::player_fill_blue));
+  params.player.outline_color =
+      sf::Color(read_config_i(config_key::player_outline_red),
+                read_config_i(config_key::player_outline_green),
+                read_config_i(config_key::player_outline_blue));
+  params.player.outline_thickness =
+      read_config_i(config_key::player_outline_thickness);
+  params.player.vertices = read_config_i(config_key::player_vertices);
+  params.player.health = read_config_i(config_key::player_health);
 
-  file.close();
+  m_params = params;
+  m_archetypes.build(m_params);
+  m_params_dirty = false;
 }
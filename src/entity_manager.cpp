@@ -12,38 +12,34 @@ const Entities & EntityManager::get_entities(const Tag tag)  {
 	return m_tag_entities[tag];
 }
 
-const std::shared_ptr<Entity> EntityManager::add_entity(const Tag tag) {
-	const std::shared_ptr<Entity> entity = std::shared_ptr<Entity>(new Entity(tag, m_entity_count++));
-	m_to_add.push_back(entity);
-	return entity;
+const Entities & EntityManager::get_pending() const {
+	return m_to_add;
 }
 
-const std::shared_ptr<Entity> EntityManager::schedule(const Tag tag) {
+const std::shared_ptr<Entity> EntityManager::add_entity(const Tag tag) {
 	const std::shared_ptr<Entity> entity = std::shared_ptr<Entity>(new Entity(tag, m_entity_count++));
-	m_scheduled.push_back(entity);
+	m_to_add.push_back(entity);
 	return entity;
 }
 
-const bool EntityManager::pop_schedule() {
-	if (m_scheduled.empty()) {
-		return false;
+const Entities EntityManager::add_entities(const Tag tag, const size_t count) {
+	const std::shared_ptr<std::vector<Entity>> block = std::make_shared<std::vector<Entity>>();
+	block->reserve(count);
+	Entities entities {};
+	entities.reserve(count);
+	for (size_t i = 0; i < count; ++i) {
+		block->emplace_back(tag, m_entity_count++);
+		const std::shared_ptr<Entity> entity = std::shared_ptr<Entity>(block, &block->back());
+		entities.push_back(entity);
+		m_to_add.push_back(entity);
 	}
-	const std::shared_ptr<Entity> entity = m_scheduled.back();
-	m_scheduled.pop_back();
-	m_to_add.push_back(entity);
-
-	if (m_scheduled.empty()) {
-		return false;
-	}
-
-	return true;
+	return entities;
 }
 
 void EntityManager::flush() {
 	m_to_add.clear();
 	m_entities.clear();
 	m_tag_entities.clear();
-	m_scheduled.clear();
 }
 
 void EntityManager::update() {
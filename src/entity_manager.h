@@ -7,7 +7,6 @@ typedef std::vector<std::shared_ptr<Entity>> Entities;
 
 class EntityManager {
 	Entities m_entities {};    
-	Entities m_scheduled {};
 	std::map<Tag, Entities> m_tag_entities {};
 	size_t m_entity_count = 0;
 	Entities m_to_add {};
@@ -16,9 +15,39 @@ public:
 	~EntityManager() {};
 	const Entities & get_entities() const;
 	const Entities & get_entities(const Tag tag);
+	// Added since the last update(), not in get_entities() yet
+	const Entities & get_pending() const;
 	const std::shared_ptr<Entity> add_entity(const Tag tag);
-	const std::shared_ptr<Entity> schedule(const Tag tag);
-	const bool pop_schedule();
+	// Adds count entities at once; they share a single allocation.
+	const Entities add_entities(const Tag tag, const size_t count);
 	void flush();
 	void update();
-};
\ No newline at end of file
+};
+
+// Gives every entity its own component built by make(i). All of them live
+// in one allocation, which each entity's pointer keeps alive.
+template <typename T, typename Make>
+void assign_components(
+	const Entities & entities
+	, std::shared_ptr<T> Entity::* component
+	, Make make
+) {
+	const std::shared_ptr<std::vector<T>> block = std::make_shared<std::vector<T>>();
+	block->reserve(entities.size());
+	for (size_t i = 0; i < entities.size(); ++i) {
+		block->push_back(make(i));
+	}
+	for (size_t i = 0; i < entities.size(); ++i) {
+		(*entities[i]).*component = std::shared_ptr<T>(block, &(*block)[i]);
+	}
+}
+
+// Gives every entity its own copy of prefab, all in one allocation.
+template <typename T>
+void assign_copies(
+	const Entities & entities
+	, std::shared_ptr<T> Entity::* component
+	, const T & prefab
+) {
+	assign_components(entities, component, [&](const size_t) { return prefab; });
+}
@@ -1,40 +1,114 @@
 #include "game.h"
 #include "vec2.h"
 #include <algorithm>
-#include <cstdlib>
-#include <ctime>
 void Game::run() {
+  Trace::set_thread_name("Simulation");
 
   while (m_running) {
-    // create/cleanup entities
-    m_entity_manager.update();
+    m_profiler.begin_frame();
+    Trace::begin_frame();
+    // Swap in an edited config file between two frames
+    if (std::unique_ptr<Config> config = m_config_watcher.take()) {
+      apply_config(*config);
+    }
+    // GUI edits from the last frame
+    if (m_params_dirty) {
+      compile_params();
+    }
+    {
+      PROFILE_SCOPE(m_profiler, Profiler::Entities);
+      // create/cleanup entities, new ones start their timers from now
+      for (const std::shared_ptr<Entity> &entity :
+           m_entity_manager.get_pending()) {
+        arm_timers(entity);
+      }
+      m_entity_manager.update();
+    }
 
     sf::Time deltaTime = m_delta_clock.restart();
+    m_governor.add_frame(deltaTime.asSeconds() * 1000.f);
 
-    // update call required by ImGui
-    ImGui::SFML::Update(m_window, deltaTime);
-
-    sUserInput();
+    {
+      PROFILE_SCOPE(m_profiler, Profiler::UserInput);
+      sUserInput();
+    }
     if (!m_paused) {
-      if (m_sInputHandling)
+      if (m_sInputHandling) {
+        PROFILE_SCOPE(m_profiler, Profiler::InputHandling);
         sInputHandling();
-      sTimers(deltaTime);
-      sEmitters(deltaTime);
-      sEffects(deltaTime);
-      sLifespan(deltaTime);
-      sDamageReact(deltaTime);
-      if (m_sMovement)
+      }
+      if (m_sFusion) {
+        // Times sTimers, sLifespan and the passes separately
+        sFusedUpdate(deltaTime);
+      } else {
+        {
+          PROFILE_SCOPE(m_profiler, Profiler::Timers);
+          sTimers(deltaTime);
+        }
+        {
+          PROFILE_SCOPE(m_profiler, Profiler::Lifespan);
+          sLifespan(deltaTime);
+        }
+        {
+          PROFILE_SCOPE(m_profiler, Profiler::Emitters);
+          sEmitters(deltaTime);
+        }
+        {
+          PROFILE_SCOPE(m_profiler, Profiler::Effects);
+          sEffects(deltaTime);
+        }
+        {
+          PROFILE_SCOPE(m_profiler, Profiler::DamageReact);
+          sDamageReact(deltaTime);
+        }
+      }
+      {
+        PROFILE_SCOPE(m_profiler, Profiler::Particles);
+        sParticles(deltaTime);
+      }
+      if (m_sMovement) {
+        PROFILE_SCOPE(m_profiler, Profiler::Movement);
         sMovement(deltaTime);
-      if (m_sCollision)
+      }
+      if (m_sCollision) {
+        PROFILE_SCOPE(m_profiler, Profiler::Collision);
         sCollision();
-      sPlayerSpawner(deltaTime);
-      if (m_sEnemySpawner)
+      }
+      {
+        PROFILE_SCOPE(m_profiler, Profiler::PlayerSpawner);
+        sPlayerSpawner(deltaTime);
+      }
+      if (m_sEnemySpawner) {
+        PROFILE_SCOPE(m_profiler, Profiler::EnemySpawner);
         sEnemySpawner(deltaTime);
+      }
+    }
+    {
+      PROFILE_SCOPE(m_profiler, Profiler::GuiWait);
+      // ImGui is still drawing the previous frame on the render thread
+      m_render_thread.wait_for_gui();
+    }
+    {
+      PROFILE_SCOPE(m_profiler, Profiler::Gui);
+      for (const sf::Event &event : m_gui_events) {
+        ImGui::SFML::ProcessEvent(event);
+      }
+      m_gui_events.clear();
+      // update call required by ImGui
+      ImGui::SFML::Update(m_window, deltaTime);
+      update_score_text();
+      if (m_sGUI)
+        sGUI();
+      m_gui_wants_mouse = ImGui::GetIO().WantCaptureMouse;
+    }
+    {
+      PROFILE_SCOPE(m_profiler, Profiler::Render);
+      // Rendering should be last
+      sRender(deltaTime);
     }
-    if (m_sGUI)
-      sGUI();
-    // Rendering should be last
-    sRender(deltaTime);
+    m_profiler.end_frame(m_entity_manager.get_entities().size());
+    // A finished capture is written out on its own thread from here
+    Trace::end_frame();
     m_frameCount++;
   }
   shutdown();
@@ -42,8 +116,10 @@ void Game::run() {
 
 void Game::setPaused(const bool paused) { m_paused = paused; }
 
-Game::Game(const std::string &userconfig, const std::string &default_config) {
+Game::Game(const std::string &userconfig, const std::string &default_config,
+           const uint64_t seed) {
   m_userconfig_file = userconfig;
+  m_seed_override = seed;
   try {
     init(userconfig);
   } catch (std::exception &e) {
@@ -64,37 +140,80 @@ void Game::init(const std::string &configfile) {
         std::string(e.what(), sizeof(e.what())) +
         " | Could not read configuration file: " + configfile);
   }
-  m_game_close_timeout = read_config_i("Global", "gameCloseTimeout");
-  const std::string font_path = read_config_s("Font", "path");
+  m_config_file = configfile;
+  compile_params();
+  m_game_close_timeout =
+      read_config_i(config_key::global_game_close_timeout);
+  // The render thread draws text with m_font; a second init (falling back
+  // to the default config) must not swap it out from under it. It is
+  // started again by create_window.
+  m_render_thread.stop();
+  const std::string font_path = read_config_s(config_key::font_path);
   m_font = sf::Font();
   if (!m_font.loadFromFile(font_path)) {
     throw std::runtime_error("Could load font at: " + font_path);
   }
+  m_metrics_font = sf::Font();
+  if (!m_metrics_font.loadFromFile(font_path)) {
+    throw std::runtime_error("Could load font at: " + font_path);
+  }
+  m_text_metrics.set_font(m_metrics_font);
 
-  std::srand(std::time(nullptr));
-  const size_t width = read_config_i("Window", "width");
-  const size_t height = read_config_i("Window", "height");
-  const size_t depth = read_config_i("Window", "depth");
-  const size_t framerate = read_config_i("Window", "refreshRate");
-  const bool fullscreen = read_config_i("Window", "fullscreen");
+  // Same seed, same run: --seed wins over Global:seed, 0 picks a random one
+  uint64_t seed = m_seed_override;
+  if (seed == 0) {
+    try {
+      seed = std::stoull(read_config_s(config_key::global_seed));
+    } catch (const std::exception &e) {
+      seed = 0;
+    }
+  }
+  if (seed == 0) {
+    seed = RandomStreams::random_seed();
+  }
+  m_random.seed(seed);
+  std::cout << "random seed: " << seed << '\n';
+  const size_t width = read_config_i(config_key::window_width);
+  const size_t height = read_config_i(config_key::window_height);
+  const size_t depth = read_config_i(config_key::window_depth);
+  const size_t framerate = read_config_i(config_key::window_refresh_rate);
+  const bool fullscreen = read_config_i(config_key::window_fullscreen);
 
-  m_enemy_spawn_interval = read_config_i("Global", "enemySpawnInterval");
+  m_enemy_spawn_interval =
+      read_config_i(config_key::global_enemy_spawn_interval);
   m_enemy_spawn_countdown = m_enemy_spawn_interval;
-  m_player_spawn_interval = read_config_i("Player", "spawnInterval");
+  m_player_spawn_interval = read_config_i(config_key::player_spawn_interval);
   m_player_spawn_countdown = m_player_spawn_interval;
 
   m_score = 0;
-  m_score_to_boss_base = read_config_i("Boss", "scoreRequirement");
+  m_displayed_score = 0;
+  m_score_to_boss_base = m_params.boss.score_requirement;
   m_score_to_boss = m_score + m_score_to_boss_base;
-  m_score_to_boss_mult = read_config_f("Boss", "scoreRequirementMultiplier");
+  m_score_to_boss_mult = m_params.boss.score_requirement_multiplier;
 
-  m_shape_rotation = read_config_f("Global", "shapeRotation");
+  m_shape_rotation = read_config_f(config_key::global_shape_rotation);
+  build_update_passes();
   m_video_modes = sf::VideoMode::getFullscreenModes();
 
   create_window(width, height, "ImGUI + SFML = <3", depth, framerate, fullscreen);
+  // Saving over the watched file must not reload the game's own output
+  m_config_writer.start(
+      [this](const std::string &filename, const std::string &text) {
+        if (filename == m_config_file) {
+          m_config_watcher.expect_write(text);
+        }
+      });
+  // read_file only touches its arguments, so it is safe to call from the
+  // watcher thread
+  m_config_watcher.start(m_config_file, m_config,
+                         [this](const std::string &path) {
+                           return read_file(path);
+                         });
 }
 
 void Game::create_window(const size_t width, const size_t height, const std::string & title, const size_t depth, const size_t framerate, const bool fullscreen) {
+  // Before the window and the world it draws are replaced
+  m_render_thread.stop();
   std::cout << "creating window\n";
   if (fullscreen) {
     m_window.create(sf::VideoMode::getDesktopMode(), title, sf::Style::Fullscreen);
@@ -103,35 +222,48 @@ void Game::create_window(const size_t width, const size_t height, const std::str
   }
   std::cout << "created\n";
   m_window.setFramerateLimit(framerate);
+  m_governor.set_budget_ms(1000.f / (framerate > 0 ? framerate : 60));
   std::cout << "set framerate limit\n";
   spawn_world();
   std::cout << "spawned world\n";
   ImGui::SFML::Init(m_window);
   std::cout << "initialized imgui\n";
+  m_render_thread.start(m_window, m_font);
+  std::cout << "started render thread\n";
 }
 void Game::create_window(const sf::VideoMode & mode, const std::string & title, const size_t framerate, const bool fullscreen) {
   create_window(mode.width, mode.height, title, mode.bitsPerPixel, framerate, fullscreen);
 }
 
 void Game::shutdown() {
+  m_config_watcher.stop();
+  // Finishes a save that is still pending
+  m_config_writer.stop();
+  m_render_thread.stop();
+  // Finishes writing a trace capture
+  Trace::shutdown();
+  m_window.setActive(true);
   m_window.close();
   ImGui::SFML::Shutdown();
 }
 
 void Game::spawn_world() {
 	m_entity_manager.flush();
+	m_spawn_scheduler.clear();
+	m_timers.clear();
+	m_particles.clear();
   const std::shared_ptr<Entity> wb =
       m_entity_manager.add_entity(Tag::WorldBounds);
   const sf::Vector2u window_res = m_window.getSize();
   wb->rect = std::make_shared<CRect>(CRect(window_res.x, window_res.y));
   const std::shared_ptr<Entity> score =
       m_entity_manager.add_entity(Tag::ScoreWindow);
-  const int font_size = read_config_i("Font", "size");
-  const int font_red = read_config_i("Font", "red");
-  const int font_green = read_config_i("Font", "green");
-  const int font_blue = read_config_i("Font", "blue");
+  const int font_size = read_config_i(config_key::font_size);
+  const int font_red = read_config_i(config_key::font_red);
+  const int font_green = read_config_i(config_key::font_green);
+  const int font_blue = read_config_i(config_key::font_blue);
   score->text = std::make_shared<CText>(CText(
-      "Score:", m_font, font_size, sf::Color(font_red, font_green, font_blue)));
+      "Score:", font_size, sf::Color(font_red, font_green, font_blue)));
   score->transform = std::make_shared<CTransform>(CTransform(Vec2(0, 0)));
 }
 
@@ -158,43 +290,59 @@ void Game::spawn_tutorial_messages() {
     const int top_a = (w_bounds.top + w_bounds.height / 2) - v_spacing;
     const int top_c = (w_bounds.top + w_bounds.height / 2) + v_spacing * 2;
     const int top_b = top_c - v_spacing;
+    // One line after the other, each spelled out a letter at a time
+    const size_t delay_a = 0;
+    const size_t delay_b = delay_a + msg_a.size() * m_sequence_spawn_delay;
+    const size_t delay_c = delay_b + msg_b.size() * m_sequence_spawn_delay;
     spawn_text_enemies(msg_c, Vec2(left_c, top_c), font_size, font_color,
-                       spacing);
+                       spacing, delay_c);
     spawn_text_enemies(msg_b, Vec2(left_b, top_b), font_size, font_color,
-                       spacing);
+                       spacing, delay_b);
     spawn_text_enemies(msg_a, Vec2(left_a, top_a), font_size, font_color,
-                       spacing);
+                       spacing, delay_a);
   }
 }
 
 void Game::spawn_text_enemies(const std::string &text, const Vec2 &position,
                               const int font_size, const sf::Color &font_color,
-                              const int spacing) {
+                              const int spacing, const size_t delay) {
+  // Laid out right to left now, spawned later from the last letter back
+  std::vector<Vec2> positions;
+  std::vector<float> widths;
   Vec2 pos = position;
   for (auto &ch : text) {
-    const CText text_shape = CText(std::string(1, ch), m_font, font_size, font_color);
-    const float width = text_shape.text.getLocalBounds().width;
-    const std::shared_ptr<Entity> enemy =
-        m_entity_manager.schedule(Tag::Enemies);
-    enemy->name = std::make_shared<CName>(CName("Text enemy"));
-    enemy->transform = std::make_shared<CTransform>(CTransform(pos));
-    enemy->text = std::make_shared<CText>(text_shape);
-    enemy->collider = std::make_shared<CCollider>(CCollider(width * 2));
-    enemy->bounce = std::make_shared<CBounce>(CBounce());
-    enemy->health = std::make_shared<CHealth>(CHealth(1));
-    enemy->score_reward = std::make_shared<CScoreReward>(CScoreReward(200));
-    enemy->lifespan = std::make_shared<CLifespan>(CLifespan(300));
+    const float width =
+        m_text_metrics.measure(std::string(1, ch), font_size).width;
+    positions.push_back(pos);
+    widths.push_back(width);
     pos.x -= width + spacing * 5;
   }
+  m_spawn_scheduler.sequence(
+      delay, m_sequence_spawn_delay, text.size(),
+      [=, this](const size_t step) {
+        const size_t i = text.size() - 1 - step;
+        const std::shared_ptr<Entity> enemy =
+            m_entity_manager.add_entity(Tag::Enemies);
+        enemy->name = std::make_shared<CName>(CName("Text enemy"));
+        enemy->transform = std::make_shared<CTransform>(CTransform(positions[i]));
+        enemy->text = std::make_shared<CText>(
+            CText(std::string(1, text[i]), font_size, font_color));
+        enemy->collider = std::make_shared<CCollider>(CCollider(widths[i] * 2));
+        enemy->bounce = std::make_shared<CBounce>(CBounce());
+        enemy->health = std::make_shared<CHealth>(CHealth(1));
+        enemy->score_reward = std::make_shared<CScoreReward>(CScoreReward(200));
+        enemy->lifespan = std::make_shared<CLifespan>(CLifespan(300));
+      });
 }
 
 void Game::on_game_over() {}
 
 void Game::on_entity_hit(Entity &entity) {
   if (entity.health) {
-    entity.health->react_countdown = entity.health->react_duration;
+    entity.health->react_countdown.start(m_tick, entity.health->react_duration);
     if (entity.invincibility) {
-      entity.invincibility->countdown = entity.invincibility->duration;
+      entity.invincibility->countdown.start(m_tick,
+                                            entity.invincibility->duration);
     }
     if (--entity.health->hp <= 0) {
       on_entity_death(entity);
@@ -202,6 +350,41 @@ void Game::on_entity_hit(Entity &entity) {
   }
 }
 
+void Game::arm_timers(const std::shared_ptr<Entity> &entity) {
+  if (entity->lifespan) {
+    entity->lifespan->countdown.arm(m_tick);
+    m_timers.insert(entity->lifespan->countdown.deadline, entity);
+  }
+  if (entity->emitter) {
+    entity->emitter->countdown.arm(m_tick);
+    m_timers.insert(entity->emitter->countdown.deadline, entity);
+  }
+  if (entity->invincibility) {
+    entity->invincibility->countdown.arm(m_tick);
+  }
+  if (entity->health) {
+    entity->health->react_countdown.arm(m_tick);
+  }
+  if (entity->weapon) {
+    entity->weapon->fire_countdown.arm(m_tick);
+  }
+  if (entity->special_weapon) {
+    entity->special_weapon->fire_countdown.arm(m_tick);
+  }
+}
+
+void Game::on_timer(Entity &entity) {
+  if (!entity.is_alive()) {
+    return;
+  }
+  if (entity.lifespan && entity.lifespan->countdown.remaining(m_tick) == 0) {
+    on_entity_death(entity);
+  }
+  if (entity.emitter && entity.emitter->countdown.remaining(m_tick) == 0) {
+    entity.destroy();
+  }
+}
+
 void Game::on_entity_death(Entity &entity) {
   if (entity.transform) {
     if (entity.spawner) {
@@ -210,16 +393,12 @@ void Game::on_entity_death(Entity &entity) {
     if (entity.pickup_spawner) {
       spawnPickup(entity.transform->position, *entity.pickup_spawner.get());
       m_enemy_spawn_interval -= m_enemy_spawn_interval *
-                                read_config_f("Global", "enemySpawnMultiplier");
+                                m_params.enemy_spawn_multiplier;
     }
   }
 
   if (entity.score_reward) {
     m_score += entity.score_reward->score;
-    for (std::shared_ptr<Entity> score :
-         m_entity_manager.get_entities(Tag::ScoreWindow)) {
-      score->text->text.setString("Score: " + std::to_string(m_score));
-    }
     if (m_score >= m_score_to_boss) {
       spawn_boss();
       m_score_to_boss_base *= m_score_to_boss_mult;
@@ -230,6 +409,19 @@ void Game::on_entity_death(Entity &entity) {
   entity.destroy();
 }
 
+// The score text is refreshed once per frame instead of on every kill, which
+// also keeps on_entity_death from touching entities other than the dying one.
+void Game::update_score_text() {
+  if (m_displayed_score == m_score) {
+    return;
+  }
+  for (std::shared_ptr<Entity> score :
+       m_entity_manager.get_entities(Tag::ScoreWindow)) {
+    score->text->string = "Score: " + std::to_string(m_score);
+  }
+  m_displayed_score = m_score;
+}
+
 void Game::on_pickup(const CWeaponPickup::PickupType type) {
   for (std::shared_ptr<Entity> player :
        m_entity_manager.get_entities(Tag::Player)) {
@@ -238,7 +430,7 @@ void Game::on_pickup(const CWeaponPickup::PickupType type) {
     }
     const int primary_power = player->weapon->power;
     const int secondary_power = player->special_weapon->power;
-    const int max_power = read_config_i("Global", "maxPower");
+    const int max_power = m_params.max_power;
     switch (type) {
     case CWeaponPickup::PickupType::ShotSingle: {
       std::cout << "Red Single!\n";
@@ -301,7 +493,7 @@ void Game::on_pickup(const CWeaponPickup::PickupType type) {
 void Game::spawnPickup(const Vec2 &position, const CPickupSpawner &spawner) {
   const CWeaponPickup &prefab = spawner.payload;
   const CShape &shape = spawner.shape;
-  const float radius = shape.shape.getRadius();
+  const float radius = shape.radius;
 
   const std::shared_ptr<Entity> pickup =
       m_entity_manager.add_entity(Tag::Pickups);
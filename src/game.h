@@ -1,6 +1,21 @@
 #pragma once
+#include "archetypes.h"
+#include "config.h"
+#include "config_keys.h"
+#include "config_watcher.h"
+#include "config_writer.h"
 #include "entity_manager.h"
-#include <SFML/Graphics/CircleShape.hpp>
+#include "params.h"
+#include "particle_system.h"
+#include "profiler.h"
+#include "quality_governor.h"
+#include "render_thread.h"
+#include "rng.h"
+#include "spawn_placer.h"
+#include "spawn_scheduler.h"
+#include "text_batch.h"
+#include "timing_wheel.h"
+#include "system_pass.h"
 #include <SFML/Graphics/Font.hpp>
 #include <SFML/Graphics/RenderWindow.hpp>
 #include <SFML/System/Clock.hpp>
@@ -9,13 +24,29 @@
 #include <imgui-SFML.h>
 #include <imgui.h>
 
-typedef std::map<std::string, std::map<std::string, std::string>> Config;
-
 class Game {
   EntityManager m_entity_manager;
+  ParticleSystem m_particles;
   Config m_config;
+  GameParams m_params;
+  EnemyArchetypes m_archetypes;
+  SpawnPlacer m_spawn_placer;
+  SpawnScheduler m_spawn_scheduler;
+  Profiler m_profiler;
+  // Simulation ticks so far, the clock every component Timer runs on
+  size_t m_tick{0};
+  // Lifespan and emitter deadlines, so expiry never scans the entities
+  TimingWheel m_timers;
+  bool m_params_dirty{false};
   std::string m_userconfig_file;
+  std::string m_config_file;
+  ConfigWatcher m_config_watcher;
+  ConfigWriter m_config_writer;
   sf::Font m_font;
+  // Separate copy for text layout on the simulation thread, so it never
+  // touches the glyph pages the render thread is drawing from
+  sf::Font m_metrics_font;
+  TextBatch m_text_metrics;
   sf::RenderWindow m_window{sf::RenderWindow()};
   std::vector<sf::VideoMode> m_video_modes;
   sf::Clock m_delta_clock{sf::Clock()};
@@ -25,32 +56,47 @@ class Game {
   int m_player_spawn_interval{100};
   int m_sequence_spawn_delay{10};
   size_t m_score{0};
+  size_t m_displayed_score{0};
   size_t m_score_to_boss{1000};
   size_t m_score_to_boss_base{1000};
   float m_score_to_boss_mult{1.5f};
   size_t m_frameCount{0};
   float m_shape_rotation{1.6f};
+  std::vector<SystemPass> m_update_passes;
+  RandomStreams m_random;
+  uint64_t m_seed_override{0}; // --seed, 0 when not given
+  std::vector<float> m_random_scratch;
+  RenderThread m_render_thread;
+  QualityGovernor m_governor;
+  std::vector<sf::Event> m_gui_events;
+  bool m_gui_wants_mouse{false};
 
   void create_window(const size_t width = 800, const size_t height = 600, const std::string & title = "SFML", const size_t depth = 32, const size_t framerate = 60, const bool fullscreen = false);
   void create_window(const sf::VideoMode & mode, const std::string & title, const size_t framerate, const bool fullscreen);
   void test_config(Config &config) const;
-  Config parse_tokens(const std::vector<std::string> &tokenstream) const;
   const Config read_file(const std::string &configfile) const;
   void export_config(Config &config, const std::string &filename) const;
-  const int read_config_i(const std::string &header, const std::string &value);
+  const int read_config_i(const ConfigKey &key) const;
+  const int read_config_i(const std::string &header,
+                          const std::string &value) const;
+  const float read_config_f(const ConfigKey &key) const;
   const float read_config_f(const std::string &header,
-                            const std::string &value);
+                            const std::string &value) const;
+  const std::string read_config_s(const ConfigKey &key) const;
   const std::string read_config_s(const std::string &header,
-                                  const std::string &value);
+                                  const std::string &value) const;
+  void write_config(const ConfigKey &key, const std::string &value);
   void write_config(const std::string &header, const std::string &item,
                     const std::string &value);
+  void compile_params();
+  void apply_config(const Config &config);
 
   const bool collides(const CTransform &transform_a,
                       const CTransform &transform_b,
                       const CCollider &collider_a,
                       const CCollider &collider_b) const;
-  const bool line_intersect(const CTransform &t_line, const CTransform &t_obj,
-                            const CLine &line, const CCollider &collider) const;
+  const bool line_intersect(const CLine &line, const CTransform &t_obj,
+                            const CCollider &collider) const;
   const Vec2 bounce_movement(const CVelocity &velocity, const CRect &bounds,
                              const CTransform &transform,
                              const CCollider &collider) const;
@@ -69,9 +115,13 @@ class Game {
   bool m_sRender{true};
   bool m_sGUI{true};
   bool m_sEnemySpawner{true};
+  bool m_sFusion{true};
+  bool m_cull{true};
+  bool m_atlas{false};
 
 public:
-  Game(const std::string &userconfig, const std::string &default_config);
+  Game(const std::string &userconfig, const std::string &default_config,
+       const uint64_t seed = 0);
   ~Game(){};
   void init(const std::string &configfile);
   void shutdown();
@@ -89,13 +139,13 @@ public:
               const float length, const float thickness,
               const sf::Color &fill_color, const sf::Color &outline_color,
               const float outline_thickness, const int lifespan);
-  void setup_random_enemy(Entity &enemy, const bool isBoss,
-                          const sf::FloatRect &spawn_bounds);
+  // count enemies (or bosses) per world, from the compiled archetypes
+  void spawn_enemies(const size_t count, const bool isBoss);
   void setup_player(Entity &player, const Vec2 &position);
   void spawn_tutorial_messages();
   void spawn_text_enemies(const std::string &text, const Vec2 &position,
                           const int font_size, const sf::Color &font_color,
-                          const int spacing);
+                          const int spacing, const size_t delay = 0);
   void shoot();
   void shootSpecialWeapon();
   void spawnSmallEntities(const Vec2 &position, const CDeathSpawner &spawner);
@@ -104,6 +154,12 @@ public:
   spawn_bullet(const Vec2 &position, const float rotation, const Vec2 &velocity,
                const CShape &bullet_prefab, const float collision_radius,
                const int lifespan);
+  const Entities spawn_bullets(const Vec2 &position,
+                               const std::vector<float> &rotations,
+                               const std::vector<Vec2> &velocities,
+                               const CShape &bullet_prefab,
+                               const float collision_radius,
+                               const int lifespan);
   const std::shared_ptr<Entity>
   spawn_special_bullet(const Vec2 &position, const float rotation,
                        const CShape &bullet_prefab,
@@ -112,6 +168,8 @@ public:
   // Hits and death:
   void on_entity_hit(Entity &entity);
   void on_entity_death(Entity &entity);
+  void arm_timers(const std::shared_ptr<Entity> &entity);
+  void on_timer(Entity &entity);
   void on_pickup(const CWeaponPickup::PickupType type);
 
   // Systems:
@@ -123,9 +181,18 @@ public:
   void sDamageReact(const sf::Time &deltaTime);
   void sEffects(const sf::Time &deltaTime);
   void sEmitters(const sf::Time &deltaTime);
+  void sParticles(const sf::Time &deltaTime);
   void sTimers(const sf::Time &deltaTime);
   void sUserInput();
   void sInputHandling();
   void sGUI();
   void sRender(const sf::Time &deltaTime);
+  void sFusedUpdate(const sf::Time &deltaTime);
+  void build_update_passes();
+  void update_score_text();
+
+  // Per-entity system updates, shared by the standalone and fused passes:
+  void update_emitter(Entity &entity);
+  void update_effects(Entity &player);
+  void update_damage_react(Entity &entity);
 };
@@ -1,9 +1,17 @@
 #include <iostream>
+#include <string>
 #include "game.h"
 
 int main(int argc, char* argv[]) {
 	try {
-		Game g("user_config.txt", "resources/config.txt");
+		// --seed <n> replays a run
+		uint64_t seed = 0;
+		for (int i = 1; i + 1 < argc; ++i) {
+			if (std::string(argv[i]) == "--seed") {
+				seed = std::stoull(argv[i + 1]);
+			}
+		}
+		Game g("user_config.txt", "resources/config.txt", seed);
 		g.run(); 
 		return 0;
 	}
@@ -0,0 +1,152 @@
+#pragma once
+#include <algorithm>
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include "component.h"
+
+// Config values used on hot paths (every shot, every spawn), compiled once
+// into plain structs by Game::compile_params() whenever the config changes.
+// Field names follow the config keys.
+
+// ShotSingle and ShotSpread (amount and spread only used by the latter)
+struct ShotParams {
+	float speed {0.f};
+	float spread {0.f}; // degrees
+	int amount {1};
+	int fire_rate {0};
+	int lifespan {0};
+	float collision_radius {0.f};
+	CShape bullet {};
+};
+
+struct LaserParams {
+	int fire_rate {0};
+	int lifespan {0};
+	float offset {0.f};
+	float length {0.f};
+	float thickness {0.f};
+	sf::Color fill_color {};
+	sf::Color outline_color {};
+	int outline_thickness {0};
+};
+
+struct ExplosionParams {
+	int fire_rate {0};
+	int lifespan {0};
+	int small_lifespan {0};
+	int speed {0};
+	int small_speed {0};
+	int small_amount {0};
+	int recursion {0};
+	float collision_radius {0.f};
+	CShape bullet {};
+};
+
+struct RotorParams {
+	float angular_speed {0.f};
+	int amount {0};
+	float radius {0.f};
+	int fire_rate {0};
+	int lifespan {0};
+	float collision_radius {0.f};
+	CShape bullet {};
+};
+
+struct FlamethrowerParams {
+	float spread {0.f}; // degrees
+	float nozzle_spread {0.f};
+	int speed {0};
+	int duration {0};
+	int fire_rate {0};
+	float offset {0.f};
+	int freq {1};
+	int quantity {0};
+	int small_lifespan {0};
+	float random_scale {1.f};
+	int fill_red_min {0};
+	int fill_red_max {0};
+	int fill_green_min {0};
+	int fill_green_max {0};
+	int fill_blue {0};
+	int alpha_min {0};
+	int alpha_max {0};
+	int radius_min {0};
+	int radius_max {0};
+	int verts_min {3};
+	int verts_max {3};
+	int amount_types {1};
+};
+
+// Weapon tables, indexed by power
+struct WeaponParams {
+	std::vector<ShotParams> shot_single {};
+	std::vector<ShotParams> shot_spread {};
+	std::vector<LaserParams> shot_laser {};
+	std::vector<ExplosionParams> special_explosion {};
+	std::vector<RotorParams> special_rotor {};
+	std::vector<FlamethrowerParams> special_flamethrower {};
+};
+
+// "Enemy" and "Boss" share their keys
+struct EnemyParams {
+	float shape_radius {0.f};
+	float collision_radius {0.f};
+	float speed_min {0.f};
+	float speed_max {0.f};
+	sf::Color outline_color {};
+	int outline_thickness {0};
+	int vertices_min {3};
+	int vertices_max {3};
+	float vert_size_multiplier {1.f};
+	float small_radius {0.f};
+	float small_collision_radius {0.f};
+	float small_speed {0.f};
+	int small_lifespan {0};
+	int small_score {0};
+	int invincibility_duration {0};
+	int score {0};
+	float score_size_multiplier {1.f};
+};
+
+struct BossParams : EnemyParams {
+	int score_requirement {0};
+	float score_requirement_multiplier {1.f};
+};
+
+struct PickupParams {
+	float shape_radius {0.f};
+	float collision_radius {0.f};
+	int outline_thickness {0};
+	int vertices {3};
+	int lifespan {0};
+};
+
+struct PlayerParams {
+	float shape_radius {0.f};
+	float collision_radius {0.f};
+	float speed {0.f};
+	int invincibility_duration {0};
+	int flicker_rate {1};
+	sf::Color fill_color {};
+	sf::Color outline_color {};
+	int outline_thickness {0};
+	int vertices {3};
+	int health {1};
+};
+
+struct GameParams {
+	int max_power {0};
+	float enemy_spawn_multiplier {0.f};
+	WeaponParams weapons {};
+	EnemyParams enemy {};
+	BossParams boss {};
+	PickupParams pickup {};
+	PlayerParams player {};
+};
+
+// Entry of a per-power table, clamped so a bad power can't read past it
+template <typename T>
+const T & at_power(const std::vector<T> & table, const int power) {
+	const int last = (int)table.size() - 1;
+	return table[std::max(0, std::min(power, last))];
+}
@@ -0,0 +1,139 @@
+#include "particle_system.h"
+#include <algorithm>
+#include <cmath>
+
+ParticlePool::ParticlePool(const size_t capacity, const bool damaging)
+	: m_capacity(std::max<size_t>(capacity, 1))
+	, m_damaging(damaging)
+{
+	m_x.resize(m_capacity, 0.f);
+	m_y.resize(m_capacity, 0.f);
+	m_vx.resize(m_capacity, 0.f);
+	m_vy.resize(m_capacity, 0.f);
+	m_radius.resize(m_capacity, 0.f);
+	m_rotation.resize(m_capacity, 0.f);
+	m_countdown.resize(m_capacity, 0);
+	m_duration.resize(m_capacity, 1);
+	m_point_count.resize(m_capacity, 3);
+	m_color.resize(m_capacity, sf::Color::Transparent);
+}
+
+void ParticlePool::emit(
+	const Vec2 & position
+	, const Vec2 & velocity
+	, const CShape & shape
+	, const int lifespan
+) {
+	const size_t idx = m_head;
+	m_x[idx] = position.x;
+	m_y[idx] = position.y;
+	m_vx[idx] = velocity.x;
+	m_vy[idx] = velocity.y;
+	m_radius[idx] = shape.radius;
+	m_rotation[idx] = shape.rotation;
+	m_countdown[idx] = std::max(lifespan, 1);
+	m_duration[idx] = std::max(lifespan, 1);
+	m_point_count[idx] = (uint8_t)std::min<size_t>(shape.point_count, 255);
+	m_color[idx] = shape.fill_color;
+	m_head = (m_head + 1) % m_capacity;
+	m_size = std::min(m_size + 1, m_capacity);
+}
+
+void ParticlePool::update(const float spin_deg) {
+	// Dead slots are updated too, so the loop has no branches
+	for (size_t i = 0; i < m_capacity; ++i) {
+		m_x[i] += m_vx[i];
+		m_y[i] += m_vy[i];
+		m_rotation[i] = std::fmod(m_rotation[i] + spin_deg, 360.f);
+		m_countdown[i] = std::max(m_countdown[i] - 1, 0);
+		// Same fade as sLifespan
+		m_color[i].a = (sf::Uint8)(m_countdown[i] * 255 / m_duration[i]);
+	}
+	while (m_size > 0 && !alive(slot(0))) {
+		--m_size;
+	}
+}
+
+void ParticlePool::clear() {
+	std::fill(m_countdown.begin(), m_countdown.end(), 0);
+	m_size = 0;
+}
+
+bool ParticlePool::damaging() const {
+	return m_damaging;
+}
+
+size_t ParticlePool::capacity() const {
+	return m_capacity;
+}
+
+size_t ParticlePool::size() const {
+	return m_size;
+}
+
+size_t ParticlePool::slot(const size_t idx) const {
+	return (m_head + m_capacity - m_size + idx) % m_capacity;
+}
+
+bool ParticlePool::alive(const size_t slot) const {
+	return m_countdown[slot] > 0;
+}
+
+float ParticlePool::x(const size_t slot) const {
+	return m_x[slot];
+}
+
+float ParticlePool::y(const size_t slot) const {
+	return m_y[slot];
+}
+
+float ParticlePool::radius(const size_t slot) const {
+	return m_radius[slot];
+}
+
+float ParticlePool::rotation(const size_t slot) const {
+	return m_rotation[slot];
+}
+
+size_t ParticlePool::point_count(const size_t slot) const {
+	return m_point_count[slot];
+}
+
+const sf::Color & ParticlePool::color(const size_t slot) const {
+	return m_color[slot];
+}
+
+ParticleSystem::ParticleSystem() {
+	// One pool per CEmitter::ParticleType, in declaration order
+	m_pools.push_back(ParticlePool(2048, true)); // Flame
+}
+
+ParticlePool & ParticleSystem::pool(const CEmitter::ParticleType type) {
+	return m_pools[type];
+}
+
+const std::vector<ParticlePool> & ParticleSystem::pools() const {
+	return m_pools;
+}
+
+void ParticleSystem::update(const float spin_deg) {
+	for (ParticlePool & pool : m_pools) {
+		pool.update(spin_deg);
+	}
+}
+
+void ParticleSystem::clear() {
+	for (ParticlePool & pool : m_pools) {
+		pool.clear();
+	}
+}
+
+size_t ParticleSystem::live_count() const {
+	size_t count = 0;
+	for (const ParticlePool & pool : m_pools) {
+		for (size_t i = 0; i < pool.size(); ++i) {
+			count += pool.alive(pool.slot(i));
+		}
+	}
+	return count;
+}
@@ -0,0 +1,66 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include "component.h"
+#include "vec2.h"
+
+// Fixed number of particles of one emitter type, stored as separate arrays.
+// New particles go in at the head of a ring; once it is full the oldest
+// particle is overwritten. Particles of one type live about as long as each
+// other, so the ring stays ordered by death and dead particles are trimmed
+// off the tail.
+class ParticlePool {
+	std::vector<float> m_x {};
+	std::vector<float> m_y {};
+	std::vector<float> m_vx {};
+	std::vector<float> m_vy {};
+	std::vector<float> m_radius {};
+	std::vector<float> m_rotation {};
+	std::vector<int> m_countdown {};
+	std::vector<int> m_duration {};
+	std::vector<uint8_t> m_point_count {};
+	std::vector<sf::Color> m_color {};
+	size_t m_capacity = 0;
+	size_t m_head = 0; // next slot to write
+	size_t m_size = 0; // slots in use, counted back from the head
+	bool m_damaging = false;
+public:
+	ParticlePool(const size_t capacity, const bool damaging);
+	~ParticlePool() {};
+	void emit(
+		const Vec2 & position
+		, const Vec2 & velocity
+		, const CShape & shape
+		, const int lifespan
+	);
+	// Moves, spins, ages and fades every particle in one pass
+	void update(const float spin_deg);
+	void clear();
+	bool damaging() const;
+	size_t capacity() const;
+	size_t size() const;
+	// Slot of the idx-th particle in use, oldest first
+	size_t slot(const size_t idx) const;
+	bool alive(const size_t slot) const;
+	float x(const size_t slot) const;
+	float y(const size_t slot) const;
+	float radius(const size_t slot) const;
+	float rotation(const size_t slot) const;
+	size_t point_count(const size_t slot) const;
+	const sf::Color & color(const size_t slot) const;
+};
+
+// Particles of every emitter type, kept out of the EntityManager.
+// Damaging pools are checked against enemies by sCollision directly.
+class ParticleSystem {
+	std::vector<ParticlePool> m_pools {};
+public:
+	ParticleSystem();
+	~ParticleSystem() {};
+	ParticlePool & pool(const CEmitter::ParticleType type);
+	const std::vector<ParticlePool> & pools() const;
+	void update(const float spin_deg);
+	void clear();
+	size_t live_count() const;
+};
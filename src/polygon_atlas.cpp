@@ -0,0 +1,157 @@
+#include "polygon_atlas.h"
+#include <cmath>
+
+void PolygonAtlas::clear() {
+	m_vertices.clear();
+	m_shape_count = 0;
+}
+
+const PolygonAtlas::Cell * PolygonAtlas::cell(const size_t point_count, const int thickness_step) {
+	const std::pair<size_t, int> key {point_count, thickness_step};
+	const auto found = m_cells.find(key);
+	if (found != m_cells.end()) {
+		return &found->second;
+	}
+
+	const unsigned int columns = atlas_size / cell_size;
+	if (m_next_slot + 2 > columns * columns) {
+		return nullptr;
+	}
+	if (!m_created) {
+		if (!m_texture.create(atlas_size, atlas_size)) {
+			return nullptr;
+		}
+		m_texture.setSmooth(true);
+		m_texture.clear(sf::Color::Transparent);
+		m_created = true;
+	}
+
+	// Scale the polygon so its outline just fits the cell, leaving a texel
+	// of padding for smoothing
+	const float thickness = (float)thickness_step / cell_radius;
+	const float miter = m_meshes.get(point_count).miter;
+	const float half = cell_size / 2.f;
+	const float outer = 1.f + std::max(thickness * miter, 0.f);
+	const float radius = cell_radius / outer;
+	const auto slot_rect = [&](const size_t slot) {
+		return sf::FloatRect(
+			(float)(slot % columns * cell_size),
+			(float)(slot / columns * cell_size),
+			(float)cell_size,
+			(float)cell_size
+		);
+	};
+	Cell cell;
+	cell.fill = slot_rect(m_next_slot);
+	cell.outline = slot_rect(m_next_slot + 1);
+	cell.extent = half / radius;
+	m_next_slot += 2;
+
+	const sf::Color white = sf::Color::White;
+	const sf::Color none = sf::Color::Transparent;
+	m_raster.clear();
+	const Vec2 fill_center(cell.fill.left + half, cell.fill.top + half);
+	const Vec2 outline_center(cell.outline.left + half, cell.outline.top + half);
+	m_raster.add_polygon(0, m_next_slot, fill_center, 0.f, 1.f, radius, point_count, white, none, 0.f);
+	m_raster.add_polygon(1, m_next_slot, outline_center, 0.f, 1.f, radius, point_count, none, white, thickness * radius);
+	sf::RenderStates states;
+	states.blendMode = sf::BlendNone;
+	m_texture.draw(m_raster, states);
+	m_texture.display();
+
+	return &m_cells.emplace(key, cell).first->second;
+}
+
+void PolygonAtlas::add_quad(
+	const sf::Vector2f (& corners)[4]
+	, const sf::FloatRect & rect
+	, const sf::Color & color
+) {
+	const sf::Vector2f uv[4] = {
+		{rect.left, rect.top},
+		{rect.left + rect.width, rect.top},
+		{rect.left + rect.width, rect.top + rect.height},
+		{rect.left, rect.top + rect.height},
+	};
+	m_vertices.append(sf::Vertex(corners[0], color, uv[0]));
+	m_vertices.append(sf::Vertex(corners[1], color, uv[1]));
+	m_vertices.append(sf::Vertex(corners[2], color, uv[2]));
+	m_vertices.append(sf::Vertex(corners[2], color, uv[2]));
+	m_vertices.append(sf::Vertex(corners[3], color, uv[3]));
+	m_vertices.append(sf::Vertex(corners[0], color, uv[0]));
+}
+
+bool PolygonAtlas::add_polygon(
+	const Vec2 & position
+	, const float rotation_deg
+	, const float scale
+	, const float radius
+	, const size_t point_count
+	, const sf::Color & fill_color
+	, const sf::Color & outline_color
+	, const float outline_thickness
+) {
+	if (point_count < 3 || radius <= 0.f) {
+		return false;
+	}
+	// Upscaling the cell would blur the shape
+	const float miter = m_meshes.get(point_count).miter;
+	const float outer = radius + std::max(outline_thickness * miter, 0.f);
+	if (outer * scale > cell_size / 2.f) {
+		return false;
+	}
+	// Outline thickness in cell pixels, as if the polygon filled the cell.
+	// A thin outline keeps at least one pixel instead of rounding away.
+	int thickness_step = (int)std::round(outline_thickness / radius * cell_radius);
+	if (thickness_step == 0 && outline_thickness != 0.f) {
+		thickness_step = outline_thickness > 0.f ? 1 : -1;
+	}
+	const Cell * found = cell(point_count, thickness_step);
+	if (!found) {
+		return false;
+	}
+
+	const float rotation = rotation_deg / Vec2::rad_to_deg;
+	const float extent = found->extent * radius * scale;
+	const float cos_r = std::cos(rotation) * extent;
+	const float sin_r = std::sin(rotation) * extent;
+	const auto corner = [&](const float x, const float y) {
+		return sf::Vector2f(
+			position.x + x * cos_r - y * sin_r,
+			position.y + x * sin_r + y * cos_r
+		);
+	};
+	const sf::Vector2f corners[4] = {
+		corner(-1.f, -1.f),
+		corner(1.f, -1.f),
+		corner(1.f, 1.f),
+		corner(-1.f, 1.f),
+	};
+	if (fill_color.a > 0) {
+		add_quad(corners, found->fill, fill_color);
+	}
+	if (thickness_step != 0 && outline_color.a > 0) {
+		add_quad(corners, found->outline, outline_color);
+	}
+	++m_shape_count;
+	return true;
+}
+
+size_t PolygonAtlas::shape_count() const {
+	return m_shape_count;
+}
+
+size_t PolygonAtlas::vertex_count() const {
+	return m_vertices.getVertexCount();
+}
+
+size_t PolygonAtlas::cell_count() const {
+	return m_cells.size();
+}
+
+void PolygonAtlas::draw(sf::RenderTarget & target, sf::RenderStates states) const {
+	if (m_vertices.getVertexCount() > 0) {
+		states.texture = &m_texture.getTexture();
+		target.draw(m_vertices, states);
+	}
+}
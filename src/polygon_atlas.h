@@ -0,0 +1,69 @@
+#pragma once
+#include <map>
+#include <utility>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/RenderTexture.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "polygon_mesh.h"
+#include "shape_batch.h"
+#include "vec2.h"
+
+// Draws polygons as textured quads instead of triangles.
+// Every kind of polygon (point count and outline thickness in cell pixels)
+// is rasterized once in white into a RenderTexture: one cell
+// with the fill and one with the outline ring. A shape then costs two
+// quads tinted with its fill and outline colours, whatever its point count.
+// Shapes bigger on screen than a cell are left to the ShapeBatch, as
+// scaling the cell up would blur them.
+// Has to be used on the thread that owns the GL context.
+class PolygonAtlas : public sf::Drawable {
+	struct Cell {
+		sf::FloatRect fill {}; // texture rects
+		sf::FloatRect outline {};
+		float extent {1.f}; // half size of the quad per unit of radius
+	};
+	static constexpr unsigned int cell_size = 64;
+	static constexpr unsigned int atlas_size = 1024;
+	// Radius of a polygon without outline in its cell, a texel of padding
+	// is left for smoothing. Outline thickness is keyed in these pixels.
+	static constexpr float cell_radius = cell_size / 2.f - 1.f;
+	sf::RenderTexture m_texture {};
+	bool m_created = false;
+	std::map<std::pair<size_t, int>, Cell> m_cells {};
+	size_t m_next_slot = 0;
+	PolygonMeshCache m_meshes {};
+	ShapeBatch m_raster {};
+	sf::VertexArray m_vertices {sf::Triangles};
+	size_t m_shape_count = 0;
+	const Cell * cell(const size_t point_count, const int thickness_step);
+	void add_quad(
+		const sf::Vector2f (& corners)[4]
+		, const sf::FloatRect & rect
+		, const sf::Color & color
+	);
+public:
+	PolygonAtlas() {};
+	~PolygonAtlas() {};
+	void clear();
+	// Returns false when the shape can't be drawn from the atlas (it is
+	// full or the shape is bigger than a cell), so the caller can fall
+	// back to the ShapeBatch.
+	bool add_polygon(
+		const Vec2 & position
+		, const float rotation_deg
+		, const float scale
+		, const float radius
+		, const size_t point_count
+		, const sf::Color & fill_color
+		, const sf::Color & outline_color
+		, const float outline_thickness
+	);
+	size_t shape_count() const;
+	size_t vertex_count() const;
+	size_t cell_count() const;
+private:
+	void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+};
@@ -0,0 +1,18 @@
+#include "polygon_mesh.h"
+
+const PolygonMesh & PolygonMeshCache::get(const size_t point_count) {
+	if (point_count >= m_meshes.size()) {
+		m_meshes.resize(point_count + 1);
+	}
+	PolygonMesh & mesh = m_meshes[point_count];
+	if (mesh.points.empty() && point_count > 0) {
+		const float step = 2.f * M_PI / point_count;
+		mesh.points.reserve(point_count);
+		for (size_t i = 0; i < point_count; ++i) {
+			const float angle = i * step - M_PI / 2.f;
+			mesh.points.push_back(Vec2(std::cos(angle), std::sin(angle)));
+		}
+		mesh.miter = 1.f / std::cos(step / 2.f);
+	}
+	return mesh;
+}
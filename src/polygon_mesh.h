@@ -0,0 +1,22 @@
+#pragma once
+#include <vector>
+#include "vec2.h"
+
+// Unit-radius regular polygon centered on the origin, first point straight
+// up like sf::CircleShape.
+struct PolygonMesh {
+	std::vector<Vec2> points {};
+	// Distance a corner moves per unit of outline thickness
+	// (1 / cos of half the corner step).
+	float miter {1.f};
+};
+
+// Builds each polygon once per point count and hands out the cached copy,
+// so shapes only need to carry their point count and radius.
+class PolygonMeshCache {
+	std::vector<PolygonMesh> m_meshes {};
+public:
+	PolygonMeshCache() {};
+	~PolygonMeshCache() {};
+	const PolygonMesh & get(const size_t point_count);
+};
@@ -0,0 +1,117 @@
+#include "profiler.h"
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+const char * const section_names[Profiler::Count] = {
+	"EntityManager::update",
+	"sUserInput",
+	"sInputHandling",
+	"sTimers",
+	"sLifespan",
+	"sEmitters",
+	"sEffects",
+	"sDamageReact",
+	"sFusedUpdate",
+	"sParticles",
+	"sMovement",
+	"sCollision",
+	"sPlayerSpawner",
+	"sEnemySpawner",
+	"GUI wait",
+	"sGUI",
+	"sRender",
+};
+
+}
+
+const char * Profiler::section_name(const Section section) {
+	return section < Count ? section_names[section] : "";
+}
+
+void Profiler::set_enabled(const bool enabled) {
+	m_enabled = enabled;
+}
+
+void Profiler::begin_frame() {
+	// Switching on halfway through a frame starts with the next one
+	m_timing = m_enabled;
+	if (!m_timing) {
+		return;
+	}
+	m_current.fill(0.f);
+	m_frame_start = Clock::now();
+}
+
+void Profiler::end_frame(const size_t entity_count) {
+	if (!m_timing || !m_enabled) {
+		return;
+	}
+	const std::chrono::duration<float, std::milli> elapsed = Clock::now() - m_frame_start;
+	for (size_t i = 0; i < Count; ++i) {
+		m_ms[i][m_cursor] = m_current[i];
+	}
+	m_frame_ms[m_cursor] = elapsed.count();
+	m_entities[m_cursor] = (float)entity_count;
+	m_cursor = (m_cursor + 1) % frames;
+	m_filled = std::min(m_filled + 1, frames);
+}
+
+void Profiler::clear() {
+	m_cursor = 0;
+	m_filled = 0;
+	m_current.fill(0.f);
+}
+
+size_t Profiler::filled() const {
+	return m_filled;
+}
+
+size_t Profiler::offset() const {
+	return m_filled < frames ? 0 : m_cursor;
+}
+
+const float * Profiler::history(const Section section) const {
+	return m_ms[section].data();
+}
+
+const float * Profiler::frame_history() const {
+	return m_frame_ms.data();
+}
+
+const float * Profiler::entity_history() const {
+	return m_entities.data();
+}
+
+Profiler::Summary Profiler::summarize(
+	const std::array<float, frames> & values
+	, const size_t filled
+	, const size_t last
+) {
+	Summary summary;
+	if (filled == 0) {
+		return summary;
+	}
+	// Until the ring wraps the frames are the ones at the front
+	std::vector<float> sorted(values.begin(), values.begin() + filled);
+	float sum = 0.f;
+	for (const float value : sorted) {
+		sum += value;
+	}
+	const size_t p99 = std::min(filled - 1, filled * 99 / 100);
+	std::nth_element(sorted.begin(), sorted.begin() + p99, sorted.end());
+	summary.p99 = sorted[p99];
+	summary.min = *std::min_element(sorted.begin(), sorted.begin() + p99 + 1);
+	summary.avg = sum / filled;
+	summary.last = values[last];
+	return summary;
+}
+
+Profiler::Summary Profiler::summary(const Section section) const {
+	return summarize(m_ms[section], m_filled, (m_cursor + frames - 1) % frames);
+}
+
+Profiler::Summary Profiler::frame_summary() const {
+	return summarize(m_frame_ms, m_filled, (m_cursor + frames - 1) % frames);
+}
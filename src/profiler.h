@@ -0,0 +1,122 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include "trace.h"
+
+// Milliseconds spent in each system, for the last `frames` frames.
+// Sections add up over a frame (a system can be entered more than once),
+// and a frame only shows up once end_frame() has copied it into the ring.
+class Profiler {
+public:
+	enum Section {
+		Entities, // EntityManager::update and arming new timers
+		UserInput,
+		InputHandling,
+		Timers,
+		Lifespan,
+		Emitters,
+		Effects,
+		DamageReact,
+		Fused, // the fused passes, without sTimers and sLifespan
+		Particles,
+		Movement,
+		Collision,
+		PlayerSpawner,
+		EnemySpawner,
+		GuiWait, // waiting for the render thread to finish with ImGui
+		Gui,
+		Render,
+		Count,
+	};
+	static constexpr size_t frames = 240;
+	struct Summary {
+		float min {0.f};
+		float avg {0.f};
+		float p99 {0.f};
+		float last {0.f};
+	};
+	typedef Trace::Clock Clock;
+private:
+	bool m_enabled = false;
+	bool m_timing = false; // enabled when the current frame began
+	std::array<float, Count> m_current {};
+	std::array<std::array<float, frames>, Count> m_ms {};
+	std::array<float, frames> m_frame_ms {};
+	std::array<float, frames> m_entities {};
+	size_t m_cursor = 0; // the oldest frame, overwritten next
+	size_t m_filled = 0;
+	Clock::time_point m_frame_start {};
+	static Summary summarize(const std::array<float, frames> & values, const size_t filled, const size_t last);
+public:
+	Profiler() {};
+	~Profiler() {};
+	static const char * section_name(const Section section);
+	// False when PROFILE_SCOPE was compiled out (cmake -DPROFILER=OFF)
+	static constexpr bool compiled_in() {
+#ifdef PROFILER_ENABLED
+		return true;
+#else
+		return false;
+#endif
+	}
+	void set_enabled(const bool enabled);
+	bool enabled() const {
+		return m_enabled;
+	}
+	void begin_frame();
+	void add(const Section section, const float ms) {
+		m_current[section] += ms;
+	}
+	void end_frame(const size_t entity_count);
+	void clear();
+	size_t filled() const;
+	// Index of the oldest recorded frame in the history arrays
+	size_t offset() const;
+	const float * history(const Section section) const;
+	const float * frame_history() const;
+	const float * entity_history() const;
+	Summary summary(const Section section) const;
+	Summary frame_summary() const;
+};
+
+// Times the enclosing scope into a Profiler section, and into the trace
+// while one is being captured. When neither is on this costs a couple of
+// branches on each end.
+class ProfileScope {
+	Profiler & m_profiler;
+	const Profiler::Section m_section;
+	const bool m_enabled;
+	const bool m_traced;
+	Profiler::Clock::time_point m_start {};
+public:
+	ProfileScope(Profiler & profiler, const Profiler::Section section)
+		: m_profiler(profiler)
+		, m_section(section)
+		, m_enabled(profiler.enabled())
+		, m_traced(Trace::recording())
+	{
+		if (m_enabled || m_traced) {
+			m_start = Profiler::Clock::now();
+		}
+	}
+	~ProfileScope() {
+		if (m_enabled || m_traced) {
+			const Profiler::Clock::time_point end = Profiler::Clock::now();
+			if (m_enabled) {
+				const std::chrono::duration<float, std::milli> elapsed = end - m_start;
+				m_profiler.add(m_section, elapsed.count());
+			}
+			if (m_traced) {
+				Trace::record(Profiler::section_name(m_section), m_start, end);
+			}
+		}
+	}
+};
+
+#ifdef PROFILER_ENABLED
+#define PROFILE_SCOPE(profiler, section) \
+	const ProfileScope PROFILE_CONCAT(profile_scope_, __LINE__)(profiler, section)
+#else
+#define PROFILE_SCOPE(profiler, section)
+#endif
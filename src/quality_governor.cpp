@@ -0,0 +1,106 @@
+#include "quality_governor.h"
+#include <algorithm>
+
+namespace {
+	// Late by this much on average over the window: drop a level
+	const float overload_ratio = 1.2f;
+	// Under this for recover_frames in a row: go back up a level
+	const float headroom_ratio = 1.05f;
+	const int recover_frames = 120;
+	// Polygons smaller than this (pixels) count as small
+	const float small_radius = 8.f;
+	const size_t small_point_count = 6;
+}
+
+QualityGovernor::QualityGovernor(const size_t window) {
+	m_frames.resize(std::max<size_t>(window, 1), 0.f);
+}
+
+void QualityGovernor::add_frame(const float ms) {
+	m_sum += ms - m_frames[m_next];
+	m_frames[m_next] = ms;
+	m_next = (m_next + 1) % m_frames.size();
+	if (!m_enabled) {
+		m_level = Level::Full;
+		return;
+	}
+	if (m_cooldown > 0) {
+		--m_cooldown;
+		return;
+	}
+
+	const float average = average_ms();
+	if (average > m_budget_ms * overload_ratio) {
+		m_headroom_frames = 0;
+		if (m_level < Level::SparseParticles) {
+			m_level = (Level)(m_level + 1);
+			// Let the window fill with frames drawn at the new level
+			m_cooldown = m_frames.size();
+		}
+	} else if (average < m_budget_ms * headroom_ratio) {
+		if (++m_headroom_frames >= recover_frames && m_level > Level::Full) {
+			m_level = (Level)(m_level - 1);
+			m_headroom_frames = 0;
+			m_cooldown = m_frames.size();
+		}
+	} else {
+		m_headroom_frames = 0;
+	}
+}
+
+void QualityGovernor::set_budget_ms(const float ms) {
+	m_budget_ms = ms;
+}
+
+void QualityGovernor::set_enabled(const bool enabled) {
+	m_enabled = enabled;
+	if (!m_enabled) {
+		m_level = Level::Full;
+		m_headroom_frames = 0;
+	}
+}
+
+bool QualityGovernor::enabled() const {
+	return m_enabled;
+}
+
+float QualityGovernor::budget_ms() const {
+	return m_budget_ms;
+}
+
+float QualityGovernor::average_ms() const {
+	return m_sum / m_frames.size();
+}
+
+QualityGovernor::Level QualityGovernor::level() const {
+	return m_level;
+}
+
+const char * QualityGovernor::level_name(const Level level) {
+	switch (level) {
+		case Level::Full: return "full";
+		case Level::ReducedDetail: return "reduced detail";
+		case Level::ThinnedParticles: return "thinned particles";
+		case Level::SparseParticles: return "sparse particles";
+	}
+	return "";
+}
+
+bool QualityGovernor::draw_outline(const float radius) const {
+	return m_level < Level::ReducedDetail || radius >= small_radius;
+}
+
+size_t QualityGovernor::point_count(const size_t point_count, const float radius) const {
+	if (m_level >= Level::ReducedDetail && radius < small_radius) {
+		return std::min(point_count, small_point_count);
+	}
+	return point_count;
+}
+
+bool QualityGovernor::draw_particle(const size_t slot) const {
+	switch (m_level) {
+		case Level::ThinnedParticles: return slot % 2 == 0;
+		case Level::SparseParticles: return slot % 4 == 0;
+		default: return true;
+	}
+}
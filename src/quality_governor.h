@@ -0,0 +1,42 @@
+#pragma once
+#include <cstddef>
+#include <vector>
+
+// Watches recent frame times against a budget and steps visual quality
+// down while frames run late, then back up once there is headroom again.
+// It only decides how things are drawn: every entity still exists, moves
+// and collides exactly the same at every level.
+class QualityGovernor {
+public:
+	enum Level {
+		Full,
+		ReducedDetail, // no outlines and fewer points on small polygons
+		ThinnedParticles, // + only every other particle is drawn
+		SparseParticles, // + only every fourth particle is drawn
+	};
+private:
+	std::vector<float> m_frames {}; // ring buffer of frame times (ms)
+	size_t m_next = 0;
+	float m_sum = 0.f;
+	float m_budget_ms = 1000.f / 60.f;
+	Level m_level = Level::Full;
+	int m_cooldown = 0; // frames until the level may change again
+	int m_headroom_frames = 0;
+	bool m_enabled = true;
+public:
+	QualityGovernor(const size_t window = 30);
+	~QualityGovernor() {};
+	void add_frame(const float ms);
+	void set_budget_ms(const float ms);
+	void set_enabled(const bool enabled);
+	bool enabled() const;
+	float budget_ms() const;
+	float average_ms() const;
+	Level level() const;
+	static const char * level_name(const Level level);
+
+	// Per-renderable decisions for the current level
+	bool draw_outline(const float radius) const;
+	size_t point_count(const size_t point_count, const float radius) const;
+	bool draw_particle(const size_t slot) const;
+};
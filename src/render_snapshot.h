@@ -0,0 +1,80 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include "vec2.h"
+
+// Everything the render thread needs to draw one renderable.
+struct RenderItem {
+	enum Primitive {
+		Polygon,
+		Line,
+		Text,
+	};
+	Primitive primitive {Primitive::Polygon};
+	Vec2 position {}; // Polygon: center, Line: world start, Text: top left
+	Vec2 end {}; // Line: world end
+	float rotation {0.f}; // Polygon: degrees
+	float scale {1.f};
+	float size {0.f}; // Polygon: radius, Line: thickness, Text: character size
+	size_t point_count {0}; // Polygon
+	size_t string {0}; // Text: index into RenderSnapshot::strings
+	size_t key {0}; // Polygon: entity id, keys the render side vertex cache
+	unsigned int version {0}; // Polygon: CShape::version
+	sf::Color fill_color {};
+	sf::Color outline_color {};
+	float outline_thickness {0.f};
+	// Polygon: lifespan fade, applied over the colours when drawn so the
+	// cached vertices stay valid (lines and text have it in their colours)
+	sf::Uint8 alpha {255};
+};
+
+// color with its alpha scaled by alpha / 255
+inline sf::Color fade(sf::Color color, const sf::Uint8 alpha) {
+	color.a = (sf::Uint8)(color.a * alpha / 255);
+	return color;
+}
+
+// A ParticleSystem particle: a filled polygon without outline.
+struct RenderParticle {
+	Vec2 position {};
+	float rotation {0.f}; // degrees
+	float radius {0.f};
+	size_t point_count {0};
+	sf::Color color {};
+};
+
+// One frame worth of renderables, written by the simulation and then only
+// read by the render thread until the next frame is handed over.
+struct RenderSnapshot {
+	std::vector<RenderItem> items {};
+	std::vector<std::string> strings {};
+	std::vector<RenderParticle> particles {};
+	sf::FloatRect view_area {}; // World-space area the window shows
+	bool render {true};
+	bool cull {true};
+	bool atlas {false}; // Polygons as textured quads from the PolygonAtlas
+	void clear() {
+		items.clear();
+		strings.clear();
+		particles.clear();
+	}
+};
+
+struct RenderStats {
+	size_t shapes {0};
+	size_t lines {0};
+	size_t particles {0};
+	size_t vertices {0};
+	size_t glyphs {0};
+	size_t cached_strings {0};
+	size_t rebuilt {0};
+	size_t atlas_shapes {0};
+	size_t atlas_cells {0};
+	size_t drawn {0};
+	size_t culled {0};
+	// CPU time to cull, batch and submit a frame, per polygon path
+	float vertex_ms {0.f};
+	float atlas_ms {0.f};
+};
@@ -0,0 +1,200 @@
+#include "render_thread.h"
+#include <cmath>
+#include <SFML/System/Clock.hpp>
+#include <imgui-SFML.h>
+#include "trace.h"
+
+RenderThread::~RenderThread() {
+	stop();
+}
+
+void RenderThread::start(sf::RenderWindow & window, const sf::Font & font) {
+	stop();
+	m_window = &window;
+	m_text_batch.set_font(font);
+	m_pending = -1;
+	m_gui_done = true;
+	m_running = true;
+	// The GL context can only be active in one thread at a time
+	m_window->setActive(false);
+	m_thread = std::thread(&RenderThread::run, this);
+}
+
+void RenderThread::stop() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_running = false;
+	}
+	m_cv.notify_all();
+	if (m_thread.joinable()) {
+		m_thread.join();
+	}
+	m_gui_done = true;
+}
+
+RenderSnapshot & RenderThread::back() {
+	return m_snapshots[m_back];
+}
+
+void RenderThread::publish() {
+	{
+		std::lock_guard<std::mutex> lock(m_mutex);
+		m_pending = m_back;
+		m_back = 1 - m_back;
+		m_gui_done = false;
+	}
+	m_cv.notify_all();
+}
+
+void RenderThread::wait_for_gui() {
+	std::unique_lock<std::mutex> lock(m_mutex);
+	m_cv.wait(lock, [this] { return m_gui_done || !m_running; });
+}
+
+RenderStats RenderThread::stats() {
+	std::lock_guard<std::mutex> lock(m_mutex);
+	return m_stats;
+}
+
+void RenderThread::run() {
+	Trace::set_thread_name("Render");
+	m_window->setActive(true);
+	while (true) {
+		std::unique_lock<std::mutex> lock(m_mutex);
+		m_cv.wait(lock, [this] { return m_pending >= 0 || !m_running; });
+		if (!m_running) {
+			break;
+		}
+		// publish() won't touch this buffer again until the GUI is done,
+		// and the simulation writes the other one in the meantime
+		const RenderSnapshot & snapshot = m_snapshots[m_pending];
+		m_pending = -1;
+		lock.unlock();
+
+		{
+			TRACE_SCOPE("Render frame");
+			m_window->clear();
+			draw(snapshot);
+			{
+				TRACE_SCOPE("ImGui render");
+				ImGui::SFML::Render(*m_window);
+			}
+		}
+
+		lock.lock();
+		m_gui_done = true;
+		lock.unlock();
+		m_cv.notify_all();
+
+		TRACE_SCOPE("Display");
+		m_window->display();
+	}
+	m_window->setActive(false);
+}
+
+void RenderThread::draw(const RenderSnapshot & snapshot) {
+	RenderStats stats {};
+	sf::Clock clock;
+	if (snapshot.render) {
+		m_culler.clear();
+		m_text_batch.clear();
+		for (const RenderItem & item : snapshot.items) {
+			switch (item.primitive) {
+			case RenderItem::Primitive::Polygon: {
+				// Outline corners stick out at most twice the thickness (triangles)
+				m_culler.add(item.position.x, item.position.y,
+					(item.size + std::abs(item.outline_thickness) * 2.f) * item.scale);
+				break;
+			}
+			case RenderItem::Primitive::Line: {
+				const Vec2 center = Vec2::lerp(item.position, item.end, 0.5f);
+				m_culler.add(center.x, center.y,
+					item.position.distance_to(item.end) / 2 + item.size + item.outline_thickness * 2);
+				break;
+			}
+			case RenderItem::Primitive::Text: {
+				const sf::FloatRect bounds = m_text_batch.measure(snapshot.strings[item.string], item.size);
+				const float half_w = (bounds.left + bounds.width) * item.scale / 2;
+				const float half_h = (bounds.top + bounds.height) * item.scale / 2;
+				m_culler.add(item.position.x + half_w, item.position.y + half_h,
+					std::sqrt(half_w * half_w + half_h * half_h));
+				break;
+			}
+			}
+		}
+		for (const RenderParticle & particle : snapshot.particles) {
+			m_culler.add(particle.position.x, particle.position.y, particle.radius);
+		}
+		if (snapshot.cull) {
+			m_culler.cull(snapshot.view_area);
+		}
+
+		m_shape_batch.clear();
+		m_atlas.clear();
+		for (size_t i = 0; i < snapshot.items.size(); ++i) {
+			if (snapshot.cull && !m_culler.visible(i)) {
+				continue;
+			}
+			const RenderItem & item = snapshot.items[i];
+			switch (item.primitive) {
+			case RenderItem::Primitive::Polygon: {
+				if (snapshot.atlas && m_atlas.add_polygon(item.position, item.rotation,
+					item.scale, item.size, item.point_count, fade(item.fill_color, item.alpha),
+					fade(item.outline_color, item.alpha), item.outline_thickness)) {
+					break;
+				}
+				m_shape_batch.add_polygon(item.key, item.version,
+					item.position, item.rotation, item.scale,
+					item.size, item.point_count, item.fill_color,
+					item.outline_color, item.outline_thickness, item.alpha);
+				break;
+			}
+			case RenderItem::Primitive::Line: {
+				m_shape_batch.add_line(item.position, item.end, item.size,
+					item.fill_color, item.outline_color, item.outline_thickness);
+				break;
+			}
+			case RenderItem::Primitive::Text: {
+				m_text_batch.add_text(item.position, snapshot.strings[item.string],
+					item.size, item.fill_color, item.scale);
+				break;
+			}
+			}
+		}
+		const size_t items = snapshot.items.size();
+		for (size_t i = 0; i < snapshot.particles.size(); ++i) {
+			if (snapshot.cull && !m_culler.visible(items + i)) {
+				continue;
+			}
+			const RenderParticle & particle = snapshot.particles[i];
+			m_shape_batch.add_particle(particle.position, particle.rotation,
+				particle.radius, particle.point_count, particle.color);
+		}
+		m_window->draw(m_atlas);
+		m_window->draw(m_shape_batch);
+		// Text goes on top, one draw per font size
+		m_window->draw(m_text_batch);
+
+		stats.shapes = m_shape_batch.shape_count() + m_atlas.shape_count();
+		stats.atlas_shapes = m_atlas.shape_count();
+		stats.atlas_cells = m_atlas.cell_count();
+		stats.lines = m_shape_batch.line_count();
+		stats.particles = m_shape_batch.particle_count();
+		stats.vertices = m_shape_batch.vertex_count() + m_atlas.vertex_count();
+		stats.rebuilt = m_shape_batch.rebuilt_count();
+		stats.glyphs = m_text_batch.glyph_count();
+		stats.cached_strings = m_text_batch.cached_strings();
+		const size_t total = m_culler.size();
+		stats.drawn = snapshot.cull ? m_culler.visible_count() : total;
+		stats.culled = total - stats.drawn;
+
+		// Smoothed separately per path so they can be compared side by side
+		const float ms = clock.getElapsedTime().asSeconds() * 1000.f;
+		float & average = snapshot.atlas ? m_atlas_ms : m_vertex_ms;
+		average = average > 0.f ? Vec2::lerp(average, ms, 0.05f) : ms;
+	}
+	stats.vertex_ms = m_vertex_ms;
+	stats.atlas_ms = m_atlas_ms;
+	std::lock_guard<std::mutex> lock(m_mutex);
+	m_stats = stats;
+}
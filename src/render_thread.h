@@ -0,0 +1,51 @@
+#pragma once
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/RenderWindow.hpp>
+#include "polygon_atlas.h"
+#include "render_snapshot.h"
+#include "shape_batch.h"
+#include "text_batch.h"
+#include "view_culler.h"
+
+// Owns all drawing to the window on a thread of its own.
+// The simulation fills the back snapshot and publishes it; the render
+// thread culls, batches and draws it, then renders the ImGui frame built
+// for it and presents. ImGui belongs to the render thread from publish()
+// until it has been drawn, so the simulation calls wait_for_gui() before
+// starting the next ImGui frame. Only the display() stall (vsync and the
+// frame limiter) and the batching overlap the next simulation step.
+class RenderThread {
+	sf::RenderWindow * m_window = nullptr;
+	std::thread m_thread {};
+	std::mutex m_mutex {};
+	std::condition_variable m_cv {};
+	RenderSnapshot m_snapshots[2] {};
+	int m_back = 0;
+	int m_pending = -1;
+	bool m_gui_done = true;
+	bool m_running = false;
+	RenderStats m_stats {};
+	// Touched by the render thread only
+	ShapeBatch m_shape_batch {};
+	PolygonAtlas m_atlas {};
+	TextBatch m_text_batch {};
+	ViewCuller m_culler {};
+	float m_vertex_ms = 0.f;
+	float m_atlas_ms = 0.f;
+
+	void run();
+	void draw(const RenderSnapshot & snapshot);
+public:
+	RenderThread() {};
+	~RenderThread();
+	void start(sf::RenderWindow & window, const sf::Font & font);
+	void stop();
+	RenderSnapshot & back();
+	void publish();
+	void wait_for_gui();
+	RenderStats stats();
+};
@@ -0,0 +1,118 @@
+#include "rng.h"
+#include <random>
+
+namespace {
+	uint64_t splitmix64(uint64_t & x) {
+		uint64_t z = (x += 0x9e3779b97f4a7c15ull);
+		z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+		z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+		return z ^ (z >> 31);
+	}
+
+	uint32_t rotl(const uint32_t x, const int k) {
+		return (x << k) | (x >> (32 - k));
+	}
+
+	// 24 random bits -> [0, 1)
+	float to_unit(const uint32_t bits) {
+		return static_cast<float>(bits >> 8) * 0x1.0p-24f;
+	}
+}
+
+Rng::Rng(const uint64_t seed) {
+	this->seed(seed);
+}
+
+void Rng::seed(const uint64_t seed) {
+	uint64_t x = seed;
+	const uint64_t a = splitmix64(x);
+	const uint64_t b = splitmix64(x);
+	m_state[0] = static_cast<uint32_t>(a);
+	m_state[1] = static_cast<uint32_t>(a >> 32);
+	m_state[2] = static_cast<uint32_t>(b);
+	m_state[3] = static_cast<uint32_t>(b >> 32);
+}
+
+uint32_t Rng::next() {
+	const uint32_t result = m_state[0] + m_state[3];
+	const uint32_t t = m_state[1] << 9;
+	m_state[2] ^= m_state[0];
+	m_state[3] ^= m_state[1];
+	m_state[1] ^= m_state[2];
+	m_state[0] ^= m_state[3];
+	m_state[2] ^= t;
+	m_state[3] = rotl(m_state[3], 11);
+	return result;
+}
+
+void Rng::jump() {
+	static const uint32_t jump_table[] = {0x8764000b, 0xf542d2d3, 0x6fa035c3, 0x77f2db5b};
+	uint32_t s[4] = {0, 0, 0, 0};
+	for (const uint32_t word : jump_table) {
+		for (int b = 0; b < 32; ++b) {
+			if (word & (1u << b)) {
+				for (int i = 0; i < 4; ++i) {
+					s[i] ^= m_state[i];
+				}
+			}
+			next();
+		}
+	}
+	for (int i = 0; i < 4; ++i) {
+		m_state[i] = s[i];
+	}
+}
+
+float Rng::uniform() {
+	return to_unit(next());
+}
+
+float Rng::uniform(const float min, const float max) {
+	return min + uniform() * (max - min);
+}
+
+int Rng::range(const int min, const int max) {
+	if (max <= min) {
+		return min;
+	}
+	const uint64_t span = static_cast<uint64_t>(max - min) + 1;
+	return min + static_cast<int>((static_cast<uint64_t>(next()) * span) >> 32);
+}
+
+void Rng::fill_uniform(float * out, const size_t count, const float min, const float max) {
+	const float scale = (max - min) * 0x1.0p-24f;
+	uint32_t bits[64];
+	for (size_t done = 0; done < count; done += 64) {
+		const size_t n = count - done < 64 ? count - done : 64;
+		// The generator itself is a serial dependency chain...
+		for (size_t i = 0; i < n; ++i) {
+			bits[i] = next();
+		}
+		// ...the conversion is not
+		for (size_t i = 0; i < n; ++i) {
+			out[done + i] = min + static_cast<float>(bits[i] >> 8) * scale;
+		}
+	}
+}
+
+void RandomStreams::seed(const uint64_t seed) {
+	m_seed = seed;
+	Rng base(seed);
+	for (Rng & stream : m_streams) {
+		stream = base;
+		base.jump();
+	}
+}
+
+uint64_t RandomStreams::seed() const {
+	return m_seed;
+}
+
+Rng & RandomStreams::stream(const Stream stream) {
+	return m_streams[stream];
+}
+
+uint64_t RandomStreams::random_seed() {
+	std::random_device device;
+	return (static_cast<uint64_t>(device()) << 32) | device();
+}
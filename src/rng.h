@@ -0,0 +1,49 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+// xoshiro128+ (Blackman / Vigna): small, fast, and good enough for games.
+// Not thread safe on purpose; every system (or thread) owns its own Rng.
+class Rng {
+	uint32_t m_state[4] {1, 2, 3, 4};
+	uint32_t next();
+public:
+	Rng(const uint64_t seed = 0);
+	~Rng() {};
+	void seed(const uint64_t seed);
+	// Advances 2^64 steps, so streams split off by jumps never overlap
+	void jump();
+	// [0, 1)
+	float uniform();
+	// [min, max)
+	float uniform(const float min, const float max);
+	// [min, max], every value equally likely
+	int range(const int min, const int max);
+	// count floats in [min, max); the conversion loop is branch free so the
+	// compiler can vectorize it
+	void fill_uniform(float * out, const size_t count, const float min = 0.f, const float max = 1.f);
+};
+
+// One independent stream per system, all derived from a single seed, so a
+// run can be replayed and systems never share (or contend for) a state.
+class RandomStreams {
+public:
+	enum Stream {
+		Emitters,
+		Enemies,
+		Weapons,
+		Count,
+	};
+private:
+	uint64_t m_seed = 0;
+	std::array<Rng, Stream::Count> m_streams {};
+public:
+	RandomStreams() {};
+	~RandomStreams() {};
+	void seed(const uint64_t seed);
+	uint64_t seed() const;
+	Rng & stream(const Stream stream);
+	// A seed from std::random_device, for runs that don't ask for one
+	static uint64_t random_seed();
+};
@@ -0,0 +1,230 @@
+#include "shape_batch.h"
+
+void ShapeBatch::clear() {
+	// Forget shapes that were not drawn last frame (dead or off screen)
+	for (auto it = m_polygons.begin(); it != m_polygons.end();) {
+		if (it->second.last_used + 1 < m_frame) {
+			it = m_polygons.erase(it);
+		} else {
+			++it;
+		}
+	}
+	m_vertices.clear();
+	m_shape_count = 0;
+	m_line_count = 0;
+	m_particle_count = 0;
+	m_rebuilt_count = 0;
+	++m_frame;
+}
+
+void ShapeBatch::add_quad(const sf::Vector2f (& corners)[4], const sf::Color & color) {
+	m_vertices.append(sf::Vertex(corners[0], color));
+	m_vertices.append(sf::Vertex(corners[1], color));
+	m_vertices.append(sf::Vertex(corners[2], color));
+	m_vertices.append(sf::Vertex(corners[2], color));
+	m_vertices.append(sf::Vertex(corners[3], color));
+	m_vertices.append(sf::Vertex(corners[0], color));
+}
+
+void ShapeBatch::build_polygon(
+	CachedPolygon & cached
+	, const float radius
+	, const size_t point_count
+	, const sf::Color & fill_color
+	, const sf::Color & outline_color
+	, const float outline_thickness
+) {
+	cached.vertices.clear();
+	const PolygonMesh & mesh = m_meshes.get(point_count);
+	const auto to_local = [](const Vec2 & point, const float r) {
+		return sf::Vector2f(point.x * r, point.y * r);
+	};
+
+	// Offsetting every edge by the outline thickness moves the corners
+	// out along their bisectors.
+	const float outline_radius = radius + outline_thickness * mesh.miter;
+	const bool has_fill = fill_color.a > 0;
+	const bool has_outline = outline_thickness != 0.f && outline_color.a > 0;
+	const sf::Vector2f center(0.f, 0.f);
+
+	for (size_t i = 0; i < point_count; ++i) {
+		const Vec2 & p_a = mesh.points[i];
+		const Vec2 & p_b = mesh.points[(i + 1) % point_count];
+		const sf::Vector2f a = to_local(p_a, radius);
+		const sf::Vector2f b = to_local(p_b, radius);
+		if (has_fill) {
+			cached.vertices.push_back(sf::Vertex(center, fill_color));
+			cached.vertices.push_back(sf::Vertex(a, fill_color));
+			cached.vertices.push_back(sf::Vertex(b, fill_color));
+		}
+		if (has_outline) {
+			const sf::Vector2f a_out = to_local(p_a, outline_radius);
+			const sf::Vector2f b_out = to_local(p_b, outline_radius);
+			cached.vertices.push_back(sf::Vertex(a, outline_color));
+			cached.vertices.push_back(sf::Vertex(a_out, outline_color));
+			cached.vertices.push_back(sf::Vertex(b, outline_color));
+			cached.vertices.push_back(sf::Vertex(b, outline_color));
+			cached.vertices.push_back(sf::Vertex(a_out, outline_color));
+			cached.vertices.push_back(sf::Vertex(b_out, outline_color));
+		}
+	}
+	++m_rebuilt_count;
+}
+
+void ShapeBatch::add_polygon(
+	const size_t key
+	, const unsigned int version
+	, const Vec2 & position
+	, const float rotation_deg
+	, const float scale
+	, const float radius
+	, const size_t point_count
+	, const sf::Color & fill_color
+	, const sf::Color & outline_color
+	, const float outline_thickness
+	, const sf::Uint8 alpha
+) {
+	if (point_count < 3 || alpha == 0) {
+		return;
+	}
+	auto found = m_polygons.find(key);
+	const bool is_new = found == m_polygons.end();
+	if (is_new) {
+		found = m_polygons.emplace(key, CachedPolygon()).first;
+	}
+	CachedPolygon & cached = found->second;
+	// Everything build_polygon bakes in, so writing a field directly can't
+	// leave stale vertices behind
+	if (is_new || cached.version != version || cached.point_count != point_count
+		|| cached.radius != radius || cached.fill_color != fill_color
+		|| cached.outline_color != outline_color
+		|| cached.outline_thickness != outline_thickness) {
+		build_polygon(cached, radius, point_count, fill_color, outline_color, outline_thickness);
+		cached.version = version;
+		cached.point_count = point_count;
+		cached.radius = radius;
+		cached.fill_color = fill_color;
+		cached.outline_color = outline_color;
+		cached.outline_thickness = outline_thickness;
+	}
+	cached.last_used = m_frame;
+
+	const float rotation = rotation_deg / Vec2::rad_to_deg;
+	const float cos_r = std::cos(rotation) * scale;
+	const float sin_r = std::sin(rotation) * scale;
+	for (const sf::Vertex & local : cached.vertices) {
+		const sf::Vector2f world(
+			position.x + local.position.x * cos_r - local.position.y * sin_r,
+			position.y + local.position.x * sin_r + local.position.y * cos_r
+		);
+		sf::Color color = local.color;
+		color.a = (sf::Uint8)(color.a * alpha / 255);
+		m_vertices.append(sf::Vertex(world, color));
+	}
+	++m_shape_count;
+}
+
+void ShapeBatch::add_particle(
+	const Vec2 & position
+	, const float rotation_deg
+	, const float radius
+	, const size_t point_count
+	, const sf::Color & color
+) {
+	if (point_count < 3 || color.a == 0) {
+		return;
+	}
+	const PolygonMesh & mesh = m_meshes.get(point_count);
+	const float rotation = rotation_deg / Vec2::rad_to_deg;
+	const float cos_r = std::cos(rotation) * radius;
+	const float sin_r = std::sin(rotation) * radius;
+	const auto to_world = [&](const Vec2 & point) {
+		return sf::Vector2f(
+			position.x + point.x * cos_r - point.y * sin_r,
+			position.y + point.x * sin_r + point.y * cos_r
+		);
+	};
+	const sf::Vector2f center(position.x, position.y);
+	sf::Vector2f a = to_world(mesh.points[0]);
+	for (size_t i = 0; i < point_count; ++i) {
+		const sf::Vector2f b = to_world(mesh.points[(i + 1) % point_count]);
+		m_vertices.append(sf::Vertex(center, color));
+		m_vertices.append(sf::Vertex(a, color));
+		m_vertices.append(sf::Vertex(b, color));
+		a = b;
+	}
+	++m_particle_count;
+}
+
+void ShapeBatch::add_line(
+	const Vec2 & start
+	, const Vec2 & end
+	, const float thickness
+	, const sf::Color & fill_color
+	, const sf::Color & outline_color
+	, const float outline_thickness
+) {
+	Vec2 dir = end - start;
+	const float length = dir.length();
+	if (length <= 0.f) {
+		return;
+	}
+	dir *= 1.f / length;
+	const Vec2 normal = Vec2(-dir.y, dir.x);
+	const float half = thickness / 2.f;
+	const auto corner = [&](const Vec2 & point, const float along, const float across) {
+		const Vec2 p = point + dir * along + normal * across;
+		return sf::Vector2f(p.x, p.y);
+	};
+
+	const sf::Vector2f inner[4] = {
+		corner(start, 0.f, -half),
+		corner(end, 0.f, -half),
+		corner(end, 0.f, half),
+		corner(start, 0.f, half),
+	};
+	if (fill_color.a > 0) {
+		add_quad(inner, fill_color);
+	}
+	if (outline_thickness != 0.f && outline_color.a > 0) {
+		const float t = outline_thickness;
+		const sf::Vector2f outer[4] = {
+			corner(start, -t, -half - t),
+			corner(end, t, -half - t),
+			corner(end, t, half + t),
+			corner(start, -t, half + t),
+		};
+		for (int i = 0; i < 4; ++i) {
+			const int next = (i + 1) % 4;
+			const sf::Vector2f side[4] = {inner[i], outer[i], outer[next], inner[next]};
+			add_quad(side, outline_color);
+		}
+	}
+	++m_line_count;
+}
+
+size_t ShapeBatch::line_count() const {
+	return m_line_count;
+}
+
+size_t ShapeBatch::particle_count() const {
+	return m_particle_count;
+}
+
+size_t ShapeBatch::shape_count() const {
+	return m_shape_count;
+}
+
+size_t ShapeBatch::vertex_count() const {
+	return m_vertices.getVertexCount();
+}
+
+size_t ShapeBatch::rebuilt_count() const {
+	return m_rebuilt_count;
+}
+
+void ShapeBatch::draw(sf::RenderTarget & target, sf::RenderStates states) const {
+	if (m_vertices.getVertexCount() > 0) {
+		target.draw(m_vertices, states);
+	}
+}
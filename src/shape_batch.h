@@ -0,0 +1,87 @@
+#pragma once
+#include <unordered_map>
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "polygon_mesh.h"
+#include "vec2.h"
+
+// Collects regular polygons and lines (fill and outline) as plain triangles
+// so that every shape in a frame goes to the GPU in a single draw call.
+// Polygons match sf::CircleShape with its origin set to the center,
+// lines match an sf::RectangleShape with its origin at (0, thickness / 2).
+// Polygon vertices are kept per key (entity) in local space, already
+// sized and coloured; while the version passed in, the size, colours and
+// detail asked for stay the same they are only scaled, rotated and moved
+// into place.
+class ShapeBatch : public sf::Drawable {
+	struct CachedPolygon {
+		unsigned int version {0};
+		size_t point_count {0};
+		float radius {0.f};
+		sf::Color fill_color {};
+		sf::Color outline_color {};
+		float outline_thickness {0.f};
+		size_t last_used {0};
+		std::vector<sf::Vertex> vertices {};
+	};
+	sf::VertexArray m_vertices {sf::Triangles};
+	PolygonMeshCache m_meshes {};
+	std::unordered_map<size_t, CachedPolygon> m_polygons {};
+	size_t m_frame = 0;
+	size_t m_shape_count = 0;
+	size_t m_line_count = 0;
+	size_t m_particle_count = 0;
+	size_t m_rebuilt_count = 0;
+	void build_polygon(
+		CachedPolygon & cached
+		, const float radius
+		, const size_t point_count
+		, const sf::Color & fill_color
+		, const sf::Color & outline_color
+		, const float outline_thickness
+	);
+	void add_quad(const sf::Vector2f (& corners)[4], const sf::Color & color);
+public:
+	ShapeBatch() {};
+	~ShapeBatch() {};
+	void clear();
+	void add_polygon(
+		const size_t key
+		, const unsigned int version
+		, const Vec2 & position
+		, const float rotation_deg
+		, const float scale
+		, const float radius
+		, const size_t point_count
+		, const sf::Color & fill_color
+		, const sf::Color & outline_color
+		, const float outline_thickness
+		, const sf::Uint8 alpha = 255 // scales the cached colours' alpha
+	);
+	// Fill only and not cached, for particles that change every frame
+	void add_particle(
+		const Vec2 & position
+		, const float rotation_deg
+		, const float radius
+		, const size_t point_count
+		, const sf::Color & color
+	);
+	void add_line(
+		const Vec2 & start
+		, const Vec2 & end
+		, const float thickness
+		, const sf::Color & fill_color
+		, const sf::Color & outline_color
+		, const float outline_thickness
+	);
+	size_t shape_count() const;
+	size_t line_count() const;
+	size_t particle_count() const;
+	size_t vertex_count() const;
+	size_t rebuilt_count() const;
+private:
+	void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+};
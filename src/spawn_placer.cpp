@@ -0,0 +1,153 @@
+#include "spawn_placer.h"
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+void SpawnPlacer::begin(const sf::FloatRect & bounds, const float cell_size, const int max_cells) {
+	m_bounds = bounds;
+	m_cols = std::clamp(static_cast<int>(std::ceil(bounds.width / cell_size)), 1, max_cells);
+	m_rows = std::clamp(static_cast<int>(std::ceil(bounds.height / cell_size)), 1, max_cells);
+	m_cell_width = bounds.width / m_cols;
+	m_cell_height = bounds.height / m_rows;
+	const size_t cells = static_cast<size_t>(m_cols * m_rows);
+	m_count.assign(cells, 0);
+	m_slot.assign(cells, 0);
+	for (std::vector<int> & bucket : m_buckets) {
+		bucket.clear();
+	}
+	m_exclusions.clear();
+	for (int cell = 0; cell < static_cast<int>(cells); ++cell) {
+		insert(cell);
+	}
+}
+
+int SpawnPlacer::cell_at(const Vec2 & position) const {
+	const int col = static_cast<int>((position.x - m_bounds.left) / m_cell_width);
+	const int row = static_cast<int>((position.y - m_bounds.top) / m_cell_height);
+	if (col < 0 || col >= m_cols || row < 0 || row >= m_rows) {
+		return -1;
+	}
+	return row * m_cols + col;
+}
+
+void SpawnPlacer::insert(const int cell) {
+	std::vector<int> & bucket = m_buckets[std::min(m_count[cell], max_density)];
+	m_slot[cell] = static_cast<int>(bucket.size());
+	bucket.push_back(cell);
+}
+
+void SpawnPlacer::remove(const int cell) {
+	// Swap with the last cell of the bucket
+	std::vector<int> & bucket = m_buckets[std::min(m_count[cell], max_density)];
+	const int last = bucket.back();
+	bucket[m_slot[cell]] = last;
+	m_slot[last] = m_slot[cell];
+	bucket.pop_back();
+}
+
+void SpawnPlacer::add_occupant(const Vec2 & position) {
+	const int cell = cell_at(position);
+	if (cell < 0 || m_count[cell] == excluded) {
+		return;
+	}
+	if (m_count[cell] < max_density) {
+		remove(cell);
+		++m_count[cell];
+		insert(cell);
+	} else {
+		++m_count[cell];
+	}
+}
+
+void SpawnPlacer::exclude(const Vec2 & center, const float radius) {
+	m_exclusions.push_back(Circle {center, radius});
+	const int col_min = std::max(0, static_cast<int>((center.x - radius - m_bounds.left) / m_cell_width));
+	const int col_max = std::min(m_cols - 1, static_cast<int>((center.x + radius - m_bounds.left) / m_cell_width));
+	const int row_min = std::max(0, static_cast<int>((center.y - radius - m_bounds.top) / m_cell_height));
+	const int row_max = std::min(m_rows - 1, static_cast<int>((center.y + radius - m_bounds.top) / m_cell_height));
+	for (int row = row_min; row <= row_max; ++row) {
+		for (int col = col_min; col <= col_max; ++col) {
+			const int cell = row * m_cols + col;
+			if (m_count[cell] == excluded) {
+				continue;
+			}
+			// Closest point of the cell to the center
+			const float left = m_bounds.left + col * m_cell_width;
+			const float top = m_bounds.top + row * m_cell_height;
+			const float dx = std::clamp(center.x, left, left + m_cell_width) - center.x;
+			const float dy = std::clamp(center.y, top, top + m_cell_height) - center.y;
+			if (dx * dx + dy * dy < radius * radius) {
+				remove(cell);
+				m_count[cell] = excluded;
+			}
+		}
+	}
+}
+
+Vec2 SpawnPlacer::place(Rng & rng) {
+	for (const std::vector<int> & bucket : m_buckets) {
+		if (bucket.empty()) {
+			continue;
+		}
+		const int cell = bucket[rng.range(0, static_cast<int>(bucket.size()) - 1)];
+		const float left = m_bounds.left + (cell % m_cols) * m_cell_width;
+		const float top = m_bounds.top + (cell / m_cols) * m_cell_height;
+		const Vec2 position(
+			rng.uniform(left, left + m_cell_width),
+			rng.uniform(top, top + m_cell_height)
+		);
+		add_occupant(position);
+		return position;
+	}
+	return farthest_from_exclusions(rng);
+}
+
+float SpawnPlacer::clearance(const Vec2 & position) const {
+	float nearest = std::numeric_limits<float>::max();
+	for (const Circle & circle : m_exclusions) {
+		const float dx = position.x - circle.center.x;
+		const float dy = position.y - circle.center.y;
+		nearest = std::min(nearest, std::sqrt(dx * dx + dy * dy) - circle.radius);
+	}
+	return nearest;
+}
+
+Vec2 SpawnPlacer::farthest_from_exclusions(Rng & rng) const {
+	// The point of a rectangle farthest from a circle is one of its corners;
+	// a few random points spread things out when several are clear
+	const float right = m_bounds.left + m_bounds.width;
+	const float bottom = m_bounds.top + m_bounds.height;
+	Vec2 best(m_bounds.left, m_bounds.top);
+	float best_clearance = clearance(best);
+	const auto consider = [&](const Vec2 & candidate) {
+		const float candidate_clearance = clearance(candidate);
+		if (candidate_clearance > best_clearance) {
+			best = candidate;
+			best_clearance = candidate_clearance;
+		}
+	};
+	consider(Vec2(right, m_bounds.top));
+	consider(Vec2(right, bottom));
+	consider(Vec2(m_bounds.left, bottom));
+	for (int i = 0; i < fallback_candidates; ++i) {
+		consider(Vec2(
+			rng.uniform(m_bounds.left, right),
+			rng.uniform(m_bounds.top, bottom)
+		));
+	}
+	return best;
+}
+
+void SpawnPlacer::place(Rng & rng, std::vector<Vec2> & positions) {
+	for (Vec2 & position : positions) {
+		position = place(rng);
+	}
+}
+
+size_t SpawnPlacer::free_cells() const {
+	size_t count = 0;
+	for (const std::vector<int> & bucket : m_buckets) {
+		count += bucket.size();
+	}
+	return count;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include "rng.h"
+#include "vec2.h"
+
+// Picks spawn positions from the free part of an area without rejection
+// loops. The area is split into a coarse grid of cells, each counting the
+// entities already in it; cells touching an exclusion circle (the player)
+// are taken out. Free cells are kept in buckets by how crowded they are,
+// so a placement picks a random cell from the emptiest bucket and a random
+// point inside it: bounded time however full the screen is. Every placed
+// point counts as an occupant, so a whole wave spreads out by itself.
+class SpawnPlacer {
+	static constexpr int max_density = 8; // cells this crowded or worse share a bucket
+	static constexpr int excluded = -1;
+	static constexpr int fallback_candidates = 8; // random points tried besides the corners
+	struct Circle {
+		Vec2 center;
+		float radius;
+	};
+	sf::FloatRect m_bounds {};
+	float m_cell_width = 1.f;
+	float m_cell_height = 1.f;
+	int m_cols = 0;
+	int m_rows = 0;
+	std::vector<int> m_count {}; // occupants per cell, excluded when taken out
+	std::vector<int> m_slot {}; // where the cell sits in its bucket
+	std::vector<int> m_buckets[max_density + 1] {};
+	std::vector<Circle> m_exclusions {};
+	int cell_at(const Vec2 & position) const;
+	void insert(const int cell);
+	void remove(const int cell);
+	// How far position is from the edge of the nearest exclusion circle,
+	// negative inside one
+	float clearance(const Vec2 & position) const;
+	Vec2 farthest_from_exclusions(Rng & rng) const;
+public:
+	SpawnPlacer() {};
+	~SpawnPlacer() {};
+	// Starts over with an empty area; cells are about cell_size wide, at
+	// most max_cells along either side
+	void begin(const sf::FloatRect & bounds, const float cell_size = 64.f, const int max_cells = 32);
+	void add_occupant(const Vec2 & position);
+	// Takes out every cell the circle reaches into
+	void exclude(const Vec2 & center, const float radius);
+	// A point in the least crowded free cell, counted as an occupant from
+	// then on. When the exclusions cover every cell it is the point found
+	// farthest from them instead.
+	Vec2 place(Rng & rng);
+	void place(Rng & rng, std::vector<Vec2> & positions);
+	size_t free_cells() const;
+};
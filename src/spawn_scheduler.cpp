@@ -0,0 +1,45 @@
+#include "spawn_scheduler.h"
+
+void SpawnScheduler::after(const size_t delay, Spawn spawn) {
+	m_queue.push(Pending {m_tick + delay, m_order++, std::move(spawn)});
+}
+
+void SpawnScheduler::step(const size_t interval, const size_t count, const size_t index, const SequenceSpawn & spawn) {
+	spawn(index);
+	if (index + 1 < count) {
+		after(interval, [this, interval, count, index, spawn] {
+			step(interval, count, index + 1, spawn);
+		});
+	}
+}
+
+void SpawnScheduler::sequence(const size_t delay, const size_t interval, const size_t count, SequenceSpawn spawn) {
+	if (count == 0) {
+		return;
+	}
+	after(delay, [this, interval, count, spawn] {
+		step(interval, count, 0, spawn);
+	});
+}
+
+void SpawnScheduler::advance() {
+	// Spawns may schedule more; those due right away still run this tick
+	while (!m_queue.empty() && m_queue.top().tick <= m_tick) {
+		const Spawn spawn = m_queue.top().spawn;
+		m_queue.pop();
+		spawn();
+	}
+	++m_tick;
+}
+
+void SpawnScheduler::clear() {
+	m_queue = {};
+}
+
+size_t SpawnScheduler::pending() const {
+	return m_queue.size();
+}
+
+size_t SpawnScheduler::tick() const {
+	return m_tick;
+}
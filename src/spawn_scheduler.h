@@ -0,0 +1,45 @@
+#pragma once
+#include <functional>
+#include <queue>
+#include <vector>
+
+// Spawns that should happen later, ordered by the simulation tick they are
+// due at. A scheduled spawn is a function that builds its entities when it
+// runs, so nothing is allocated ahead of time. Sequences keep a single
+// entry that reschedules itself, so any number of them can run side by
+// side, each at its own interval. Spawns due on the same tick run in the
+// order they were scheduled.
+class SpawnScheduler {
+public:
+	typedef std::function<void()> Spawn;
+	// Gets the index of the step within its sequence
+	typedef std::function<void(const size_t)> SequenceSpawn;
+private:
+	struct Pending {
+		size_t tick;
+		size_t order;
+		Spawn spawn;
+	};
+	struct Later {
+		bool operator()(const Pending & a, const Pending & b) const {
+			return a.tick != b.tick ? a.tick > b.tick : a.order > b.order;
+		}
+	};
+	std::priority_queue<Pending, std::vector<Pending>, Later> m_queue {};
+	size_t m_tick = 0;
+	size_t m_order = 0;
+	void step(const size_t interval, const size_t count, const size_t index, const SequenceSpawn & spawn);
+public:
+	SpawnScheduler() {};
+	~SpawnScheduler() {};
+	// Runs spawn once, delay ticks from now (0: on the next advance())
+	void after(const size_t delay, Spawn spawn);
+	// Runs spawn(0) .. spawn(count - 1), interval ticks apart, starting
+	// delay ticks from now
+	void sequence(const size_t delay, const size_t interval, const size_t count, SequenceSpawn spawn);
+	// Runs everything due by now, then moves on to the next tick
+	void advance();
+	void clear();
+	size_t pending() const;
+	size_t tick() const;
+};
@@ -0,0 +1,78 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+#include "component.h"
+
+class Entity;
+class Game;
+
+typedef uint32_t ComponentMask;
+
+constexpr ComponentMask component_bit(const ComponentType type) {
+	return 1u << type;
+}
+
+// A system that does its work one entity at a time.
+// reads / writes describe components of the entity being updated,
+// foreign_reads / foreign_writes describe components of any other entity
+// the system touches while updating it (parent transforms, the player, etc).
+struct EntitySystem {
+	std::string name;
+	void (Game::*update)(Entity & entity);
+	ComponentMask reads {0};
+	ComponentMask writes {0};
+	ComponentMask foreign_reads {0};
+	ComponentMask foreign_writes {0};
+	int tag {-1}; // -1 runs on every entity
+};
+
+// Systems that can share one traversal of the entity list.
+// Every entity runs through all of them in declaration order before
+// the next entity is visited.
+struct SystemPass {
+	std::vector<EntitySystem> systems;
+};
+
+// Two systems can only be fused when neither one reaches into another
+// entity for a component the other one writes: once fused, that other
+// entity may or may not have been updated yet.
+inline bool systems_compatible(const EntitySystem & a, const EntitySystem & b) {
+	const ComponentMask a_touch = a.reads | a.writes;
+	const ComponentMask b_touch = b.reads | b.writes;
+	if (a.foreign_reads & (b.writes | b.foreign_writes)) {
+		return false;
+	}
+	if (b.foreign_reads & (a.writes | a.foreign_writes)) {
+		return false;
+	}
+	if (a.foreign_writes & (b_touch | b.foreign_reads | b.foreign_writes)) {
+		return false;
+	}
+	if (b.foreign_writes & (a_touch | a.foreign_reads | a.foreign_writes)) {
+		return false;
+	}
+	return true;
+}
+
+// Groups an ordered list of systems into as few passes as possible
+// without reordering them.
+inline std::vector<SystemPass> fuse_systems(const std::vector<EntitySystem> & systems) {
+	std::vector<SystemPass> passes {};
+	for (const EntitySystem & system : systems) {
+		bool fits = !passes.empty();
+		if (fits) {
+			for (const EntitySystem & other : passes.back().systems) {
+				if (!systems_compatible(system, other)) {
+					fits = false;
+					break;
+				}
+			}
+		}
+		if (!fits) {
+			passes.push_back(SystemPass());
+		}
+		passes.back().systems.push_back(system);
+	}
+	return passes;
+}
@@ -4,7 +4,8 @@ void Game::sCollision() {
   for (const std::shared_ptr<Entity> enemy :
        m_entity_manager.get_entities(Tag::Enemies)) {
     if (!enemy->is_alive() ||
-        (enemy->invincibility && enemy->invincibility->countdown > 0)) {
+        (enemy->invincibility &&
+         enemy->invincibility->countdown.remaining(m_tick) > 0)) {
       continue;
     }
     if (enemy->transform && enemy->collider) {
@@ -21,18 +22,37 @@ void Game::sCollision() {
           }
         }
         if (bullet->transform && bullet->line) {
-          if (line_intersect(*bullet->transform.get(), *enemy->transform.get(),
-                             *bullet->line.get(), *enemy->collider.get())) {
+          if (line_intersect(*bullet->line.get(), *enemy->transform.get(),
+                             *enemy->collider.get())) {
             on_entity_hit(*bullet.get());
             on_entity_hit(*enemy.get());
           }
         }
       }
+      // Damaging particles hurt enemies on every frame they overlap,
+      // and are not used up by it
+      const Vec2 &enemy_pos = enemy->transform->position;
+      const float enemy_radius = enemy->collider->radius;
+      for (const ParticlePool &pool : m_particles.pools()) {
+        if (!pool.damaging()) {
+          continue;
+        }
+        for (size_t i = 0; i < pool.size() && enemy->is_alive(); ++i) {
+          const size_t slot = pool.slot(i);
+          const float dx = pool.x(slot) - enemy_pos.x;
+          const float dy = pool.y(slot) - enemy_pos.y;
+          const float radius_sum = pool.radius(slot) + enemy_radius;
+          if (pool.alive(slot) && dx * dx + dy * dy < radius_sum * radius_sum) {
+            on_entity_hit(*enemy.get());
+          }
+        }
+      }
       for (const std::shared_ptr<Entity> player :
            m_entity_manager.get_entities(Tag::Player)) {
         if (player->transform && player->collider) {
           if (!player->is_alive() ||
-              (player->invincibility && player->invincibility->countdown > 0)) {
+              (player->invincibility &&
+               player->invincibility->countdown.remaining(m_tick) > 0)) {
             continue;
           }
           if (collides(*player->transform.get(), *enemy->transform.get(),
@@ -74,13 +94,10 @@ const bool Game::collides(const CTransform &t_a, const CTransform &t_b,
   return false;
 }
 
-const bool Game::line_intersect(const CTransform &t_line,
-                                const CTransform &t_obj, const CLine &line,
+const bool Game::line_intersect(const CLine &line, const CTransform &t_obj,
                                 const CCollider &collider) const {
   const float dist_sq = Vec2::distance_to_line_sq(
-      t_line.position + line.start.clone().rotate_rad(t_line.rotation),
-      t_line.position + line.end.clone().rotate_rad(t_line.rotation),
-      t_obj.position);
+      line.world_start, line.world_end, t_obj.position);
   if (dist_sq < collider.radius * collider.radius) {
     return true;
   }
@@ -2,22 +2,20 @@
 
 void Game::sDamageReact(const sf::Time &deltaTime) {
   for (std::shared_ptr<Entity> entity : m_entity_manager.get_entities()) {
-    if (entity->health) {
-      CHealth &health = *entity->health.get();
-      if (entity->shape) {
-        sf::CircleShape &shape = entity->shape->shape;
-        const float scale =
-            1.f + (health.expansion - 1.f) * ((float)health.react_countdown /
-                                              (float)health.react_duration);
-        shape.setScale(scale, scale);
-      }
-      if (entity->text) {
-        sf::Text &shape = entity->text->text;
-        const float scale =
-            1.f + (health.expansion - 1.f) * ((float)health.react_countdown /
-                                              (float)health.react_duration);
-        shape.setScale(scale, scale);
-      }
+    update_damage_react(*entity.get());
+  }
+}
+
+void Game::update_damage_react(Entity &entity) {
+  if (entity.health) {
+    CHealth &health = *entity.health.get();
+    const float react = (float)health.react_countdown.remaining(m_tick) /
+                        (float)health.react_duration;
+    if (entity.shape) {
+      entity.shape->scale = 1.f + (health.expansion - 1.f) * react;
+    }
+    if (entity.text) {
+      entity.text->scale = 1.f + (health.expansion - 1.f) * react;
     }
   }
 }
@@ -3,52 +3,50 @@
 void Game::sEmitters(const sf::Time &deltaTime) {
   for (const std::shared_ptr<Entity> entity :
        m_entity_manager.get_entities(Tag::Emitters)) {
-    if (entity->emitter && entity->transform) {
-      const CEmitter &emitter = *entity->emitter.get();
-      if (emitter.countdown > 0) {
-        const Vec2 &parent_pos = emitter.parent.position;
-        const float parent_rot = emitter.parent.rotation;
+    update_emitter(*entity.get());
+  }
+}
+
+void Game::sParticles(const sf::Time &deltaTime) {
+  m_particles.update(m_shape_rotation);
+}
+
+void Game::update_emitter(Entity &entity) {
+  if (entity.emitter && entity.transform) {
+    const CEmitter &emitter = *entity.emitter.get();
+    const int countdown = emitter.countdown.remaining(m_tick);
+    // Running out is handled by the timing wheel (on_timer)
+    if (countdown > 0) {
+      const Vec2 &parent_pos = emitter.parent.position;
+      const float parent_rot = emitter.parent.rotation;
 
-        if (emitter.countdown % emitter.freq == 0) {
-          for (int i = 0; i < emitter.quantity; ++i) {
-            const int rand_idx =
-                std::round((float)(std::rand()) / (float)(RAND_MAX) *
-                           (emitter.particles.size() - 1));
-            const float rand_angle =
-                (float)(std::rand()) / (float)(RAND_MAX)*emitter.angle -
-                emitter.angle / 2;
-            const int lifespan =
-                emitter.lifespan +
-                emitter.lifespan * ((emitter.scale_mult - 1) *
-                                    ((float)std::rand() / (float)RAND_MAX));
-            const float speed =
-                emitter.speed +
-                emitter.speed * ((emitter.scale_mult - 1) *
-                                 ((float)std::rand() / (float)RAND_MAX));
+      if (countdown % emitter.freq == 0) {
+        // Four numbers per particle, drawn in one batch
+        Rng &rng = m_random.stream(RandomStreams::Emitters);
+        m_random_scratch.resize(emitter.quantity * 4);
+        rng.fill_uniform(m_random_scratch.data(), m_random_scratch.size());
+        for (int i = 0; i < emitter.quantity; ++i) {
+          const float *rand = &m_random_scratch[i * 4];
+          const int rand_idx =
+              std::min((int)(rand[0] * emitter.particles.size()),
+                       (int)emitter.particles.size() - 1);
+          const float rand_angle = rand[1] * emitter.angle - emitter.angle / 2;
+          const int lifespan =
+              emitter.lifespan +
+              emitter.lifespan * ((emitter.scale_mult - 1) * rand[2]);
+          const float speed =
+              emitter.speed + emitter.speed * ((emitter.scale_mult - 1) * rand[3]);
 
-            CShape shape = emitter.particles[rand_idx];
-            const float collider_radius = shape.shape.getRadius();
-            const Vec2 pos =
-                parent_pos + emitter.offset.clone().rotate_rad(
-                                 emitter.parent.rotation + rand_angle * emitter.nozzleSpread);
-            const Vec2 vel =
-                Vec2::forward().rotate_rad(parent_rot).rotate_rad(rand_angle) *
-                speed;
+          const CShape &shape = emitter.particles[rand_idx];
+          const Vec2 pos =
+              parent_pos + emitter.offset.clone().rotate_rad(
+                               emitter.parent.rotation + rand_angle * emitter.nozzleSpread);
+          const Vec2 vel =
+              Vec2::forward().rotate_rad(parent_rot).rotate_rad(rand_angle) *
+              speed;
 
-            const std::shared_ptr<Entity> particle =
-                m_entity_manager.add_entity(Tag::Bullets);
-            particle->transform =
-                std::make_shared<CTransform>(CTransform(pos, parent_rot));
-            particle->velocity = std::make_shared<CVelocity>(CVelocity(vel));
-            particle->shape = std::make_shared<CShape>(CShape(shape));
-            particle->collider =
-                std::make_shared<CCollider>(CCollider(collider_radius));
-            particle->lifespan =
-                std::make_shared<CLifespan>(CLifespan(lifespan));
-          }
+          m_particles.pool(emitter.type).emit(pos, vel, shape, lifespan);
         }
-      } else {
-        entity->destroy();
       }
     }
   }
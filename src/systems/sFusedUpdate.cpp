@@ -0,0 +1,49 @@
+#include "../game.h"
+
+void Game::build_update_passes() {
+  const ComponentMask transform = component_bit(ComponentType::Transform);
+  const ComponentMask shape = component_bit(ComponentType::Shape);
+  const ComponentMask text = component_bit(ComponentType::Text);
+  const ComponentMask health = component_bit(ComponentType::Health);
+  const ComponentMask invincibility =
+      component_bit(ComponentType::Invincibility);
+  const ComponentMask emitter = component_bit(ComponentType::Emitter);
+
+  // Declared in the same order the standalone systems run in Game::run.
+  // sTimers and sLifespan work off the clock and the timing wheel instead
+  // of visiting every entity, so they run ahead of the passes.
+  // {name, update, reads, writes, foreign reads, foreign writes, tag}
+  const std::vector<EntitySystem> systems{
+      // Follows the parent (player) transform and spawns particles.
+      {"sEmitters", &Game::update_emitter, emitter | transform, 0, transform,
+       0, Tag::Emitters},
+      {"sEffects", &Game::update_effects,
+       component_bit(ComponentType::PlayerStats) | invincibility | shape,
+       shape, 0, 0, Tag::Player},
+      {"sDamageReact", &Game::update_damage_react, health | shape | text,
+       shape | text, 0, 0},
+  };
+  m_update_passes = fuse_systems(systems);
+}
+
+void Game::sFusedUpdate(const sf::Time &deltaTime) {
+  {
+    PROFILE_SCOPE(m_profiler, Profiler::Timers);
+    sTimers(deltaTime);
+  }
+  {
+    PROFILE_SCOPE(m_profiler, Profiler::Lifespan);
+    sLifespan(deltaTime);
+  }
+  PROFILE_SCOPE(m_profiler, Profiler::Fused);
+  for (const SystemPass &pass : m_update_passes) {
+    for (const std::shared_ptr<Entity> &entity :
+         m_entity_manager.get_entities()) {
+      for (const EntitySystem &system : pass.systems) {
+        if (system.tag < 0 || system.tag == entity->tag()) {
+          (this->*system.update)(*entity.get());
+        }
+      }
+    }
+  }
+}
@@ -1,4 +1,6 @@
 #include "../game.h"
+#include <cfloat>
+#include <ctime>
 #include <set>
 
 void Game::sGUI() {
@@ -15,7 +17,13 @@ void Game::sGUI() {
   const int msg_timeout = 100;
   static int saved_timeout = 0;
   if (ImGui::Button("Save")) {
-    export_config(m_config, m_userconfig_file);
+    // Written on the writer thread; the message shows once it is on disk
+    m_config_writer.save(m_config, m_userconfig_file);
+  }
+  static size_t seen_saves = 0;
+  const size_t saves = m_config_writer.saves();
+  if (saves != seen_saves) {
+    seen_saves = saves;
     saved_timeout = msg_timeout;
   }
   if (saved_timeout > 0) {
@@ -23,6 +31,28 @@ void Game::sGUI() {
     ImGui::SameLine();
     ImGui::TextColored({0.f, 1.f, 0.f, (float)saved_timeout / msg_timeout}, "Configuration saved");
   }
+  static size_t seen_reloads = 0;
+  static int reloaded_timeout = 0;
+  const size_t reloads = m_config_watcher.reloads();
+  if (reloads != seen_reloads) {
+    seen_reloads = reloads;
+    reloaded_timeout = msg_timeout;
+  }
+  if (reloaded_timeout > 0) {
+    --reloaded_timeout;
+    ImGui::TextColored({0.f, 1.f, 0.f, (float)reloaded_timeout / msg_timeout},
+                       "Reloaded %s", m_config_watcher.path().c_str());
+  }
+  const std::string save_error = m_config_writer.error();
+  if (!save_error.empty()) {
+    ImGui::TextColored({1.f, 0.f, 0.f, 1.f}, "Save failed: %s",
+                       save_error.c_str());
+  }
+  const std::string reload_error = m_config_watcher.error();
+  if (!reload_error.empty()) {
+    ImGui::TextColored({1.f, 0.f, 0.f, 1.f}, "Config reload failed: %s",
+                       reload_error.c_str());
+  }
   static std::vector<Vec2> vectors{};
 
   ImGuiTabBarFlags tab_bar_flags = ImGuiTabBarFlags_Reorderable;
@@ -204,7 +234,8 @@ void Game::sGUI() {
               entity->collider = std::make_shared<CCollider>(CCollider());
             }
             if (entity->lifespan) {
-              const int countdown = entity->lifespan->countdown;
+              const int countdown =
+                  entity->lifespan->countdown.remaining(m_tick);
               const int duration = entity->lifespan->duration;
               char buf[32];
               sprintf(buf, "Lifespan: %d/%d##comp_collider", countdown,
@@ -214,13 +245,17 @@ void Game::sGUI() {
               }
             } else if (ImGui::Button("+Lifespan##add_lifespan")) {
               entity->lifespan = std::make_shared<CLifespan>(CLifespan());
+              entity->lifespan->countdown.start(m_tick,
+                                                entity->lifespan->duration);
+              m_timers.insert(entity->lifespan->countdown.deadline, entity);
             }
             if (entity->health) {
               const int hp = entity->health->hp;
               const int max_hp = entity->health->max_hp;
               const float expansion = entity->health->expansion;
               const int duration = entity->health->react_duration;
-              const int countdown = entity->health->react_countdown;
+              const int countdown =
+                  entity->health->react_countdown.remaining(m_tick);
               char buf[32];
               sprintf(buf, "HP: %d/%d, Ex%.3f D%d/%d##comp_collider", hp,
                       max_hp, expansion, duration, countdown);
@@ -231,9 +266,8 @@ void Game::sGUI() {
               entity->health = std::make_shared<CHealth>(CHealth());
             }
             if (entity->shape) {
-              const sf::CircleShape &shape = entity->shape->shape;
-              const float radius = shape.getRadius();
-              const float scale = shape.getScale().x;
+              const float radius = entity->shape->radius;
+              const float scale = entity->shape->scale;
               char buf[32];
               sprintf(buf, "Shape R:%.3f S:%.3f##comp_shape", radius, scale);
               if (ImGui::Selectable(buf, comp_idx == ComponentType::Shape)) {
@@ -256,8 +290,49 @@ void Game::sGUI() {
       ImGui::Checkbox("sCollision", &m_sCollision);
       ImGui::Checkbox("sInputHandling", &m_sInputHandling);
       ImGui::Checkbox("sRender", &m_sRender);
+      // Numbers from the last frame the render thread finished
+      const RenderStats render_stats = m_render_thread.stats();
+      ImGui::SameLine();
+      ImGui::Text("shapes: %zu, lines: %zu, vertices: %zu",
+                  render_stats.shapes, render_stats.lines,
+                  render_stats.vertices);
+      ImGui::Text("particles: %zu live, %zu drawn", m_particles.live_count(),
+                  render_stats.particles);
+      ImGui::Text("rebuilt shapes: %zu", render_stats.rebuilt);
+      ImGui::Text("glyphs: %zu, cached strings: %zu", render_stats.glyphs,
+                  render_stats.cached_strings);
+      ImGui::Checkbox("View culling", &m_cull);
+      ImGui::SameLine();
+      ImGui::Text("drawn: %zu, culled: %zu", render_stats.drawn,
+                  render_stats.culled);
+      ImGui::Checkbox("Polygon atlas", &m_atlas);
+      ImGui::SameLine();
+      ImGui::Text("quads: %zu, cells: %zu", render_stats.atlas_shapes,
+                  render_stats.atlas_cells);
+      ImGui::Text("render ms, vertex arrays: %.3f, atlas: %.3f",
+                  render_stats.vertex_ms, render_stats.atlas_ms);
+      bool governor = m_governor.enabled();
+      if (ImGui::Checkbox("Quality governor", &governor)) {
+        m_governor.set_enabled(governor);
+      }
+      ImGui::SameLine();
+      ImGui::Text("%s, frame %.2f / %.2f ms",
+                  QualityGovernor::level_name(m_governor.level()),
+                  m_governor.average_ms(), m_governor.budget_ms());
+      ImGui::Text("Random seed: %llu (--seed to replay)",
+                  (unsigned long long)m_random.seed());
       ImGui::DragFloat("rotation", &m_shape_rotation, 0.1f, 0.0f, 10.f, "%.1f");
       ImGui::Checkbox("sGUI", &m_sGUI);
+      ImGui::Checkbox("Fused update", &m_sFusion);
+      if (m_sFusion) {
+        for (int i = 0; i < m_update_passes.size(); ++i) {
+          std::string names;
+          for (const EntitySystem &system : m_update_passes[i].systems) {
+            names += (names.empty() ? "" : ", ") + system.name;
+          }
+          ImGui::Text("Pass %d: %s", i, names.c_str());
+        }
+      }
       ImGui::Checkbox("sEnemySpawner", &m_sEnemySpawner);
       ImGui::SameLine();
       if (ImGui::Button("Spawn")) {
@@ -267,18 +342,143 @@ void Game::sGUI() {
       if (ImGui::Button("Boss")) {
         spawn_boss();
       }
+      ImGui::SameLine();
+      if (ImGui::Button("Wave")) {
+        // 100 enemies in groups of 10, half a second apart
+        m_spawn_scheduler.sequence(0, 30, 10, [this](const size_t) {
+          spawn_enemies(10, false);
+        });
+      }
       ImGui::ProgressBar((float)m_enemy_spawn_countdown /
                          (float)m_enemy_spawn_interval);
       ImGui::DragInt("spawn interval", &m_enemy_spawn_interval, 10.f, 0, 1000);
-      static float multiplier = read_config_f("Global", "enemySpawnMultiplier");
+      static float multiplier =
+          read_config_f(config_key::global_enemy_spawn_multiplier);
       if (ImGui::DragFloat("multiplier", &multiplier, 0.1f, 0.0f, 1.0f)) {
-        write_config("Global", "enemySpawnMultiplier",
+        write_config(config_key::global_enemy_spawn_multiplier,
                      std::to_string(multiplier));
       };
       ImGui::EndGroup();
 
       ImGui::EndTabItem();
     }
+    if (ImGui::BeginTabItem("Profiler")) {
+      if (!Profiler::compiled_in()) {
+        ImGui::TextDisabled("Built without the profiler (-DPROFILER=OFF)");
+      }
+      bool record = m_profiler.enabled();
+      if (ImGui::Checkbox("Record", &record)) {
+        m_profiler.set_enabled(record);
+      }
+      ImGui::SameLine();
+      if (ImGui::Button("Clear##profiler")) {
+        m_profiler.clear();
+      }
+      // Chrome trace-event JSON of the next frames, for ui.perfetto.dev
+      static int trace_frames = 120;
+      ImGui::InputInt("frames##trace_frames", &trace_frames);
+      ImGui::SameLine();
+      if (Trace::busy()) {
+        if (Trace::recording()) {
+          ImGui::Text("Capturing, %zu frames left", Trace::frames_left());
+        } else {
+          ImGui::Text("Writing trace");
+        }
+      } else {
+        if (ImGui::Button("Capture trace")) {
+          Trace::capture(std::max(trace_frames, 1),
+                         "trace_" + std::to_string(std::time(nullptr)) +
+                             ".json");
+        }
+        ImGui::SameLine();
+        ImGui::Text("%s", Trace::status().c_str());
+      }
+      const size_t filled = m_profiler.filled();
+      const size_t offset = m_profiler.offset();
+      const Profiler::Summary frame = m_profiler.frame_summary();
+      ImGui::SameLine();
+      ImGui::Text("%zu frames, frame ms min %.2f avg %.2f p99 %.2f", filled,
+                  frame.min, frame.avg, frame.p99);
+      const auto section_color = [](const size_t section) {
+        return ImColor::HSV((float)section / (float)Profiler::Count, 0.6f,
+                            0.9f);
+      };
+
+      // Every frame is a column with the systems stacked bottom to top,
+      // scaled so the frame budget sits at two thirds of the height
+      const ImVec2 origin = ImGui::GetCursorScreenPos();
+      const ImVec2 size(ImGui::GetContentRegionAvail().x, 160.f);
+      ImDrawList *draw_list = ImGui::GetWindowDrawList();
+      draw_list->AddRectFilled(origin,
+                               ImVec2(origin.x + size.x, origin.y + size.y),
+                               IM_COL32(20, 20, 20, 255));
+      const float budget = m_governor.budget_ms();
+      const float top_ms = std::max(budget * 1.5f, frame.p99);
+      const float column = size.x / Profiler::frames;
+      for (size_t i = 0; i < filled; ++i) {
+        const size_t idx = (offset + i) % Profiler::frames;
+        const float left = origin.x + i * column;
+        float y = origin.y + size.y;
+        for (size_t section = 0; section < Profiler::Count; ++section) {
+          const float ms =
+              m_profiler.history((Profiler::Section)section)[idx];
+          const float height = std::min(ms / top_ms * size.y, y - origin.y);
+          if (height <= 0.f) {
+            continue;
+          }
+          draw_list->AddRectFilled(ImVec2(left, y - height),
+                                   ImVec2(left + column, y),
+                                   section_color(section));
+          y -= height;
+        }
+      }
+      const float budget_y = origin.y + size.y - budget / top_ms * size.y;
+      draw_list->AddLine(ImVec2(origin.x, budget_y),
+                         ImVec2(origin.x + size.x, budget_y),
+                         IM_COL32(255, 255, 255, 160));
+      ImGui::Dummy(size);
+
+      if (ImGui::BeginTable("Profiler sections", 5,
+                            ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg)) {
+        ImGui::TableSetupColumn("System");
+        ImGui::TableSetupColumn("last ms");
+        ImGui::TableSetupColumn("min");
+        ImGui::TableSetupColumn("avg");
+        ImGui::TableSetupColumn("p99");
+        ImGui::TableHeadersRow();
+        for (size_t section = 0; section < Profiler::Count; ++section) {
+          const Profiler::Section id = (Profiler::Section)section;
+          const Profiler::Summary summary = m_profiler.summary(id);
+          ImGui::TableNextRow();
+          ImGui::TableNextColumn();
+          ImGui::TextColored(section_color(section), "%s",
+                             Profiler::section_name(id));
+          ImGui::TableNextColumn();
+          ImGui::Text("%.3f", summary.last);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.3f", summary.min);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.3f", summary.avg);
+          ImGui::TableNextColumn();
+          ImGui::Text("%.3f", summary.p99);
+        }
+        ImGui::EndTable();
+      }
+
+      const size_t entities = m_entity_manager.get_entities().size();
+      char overlay[32];
+      sprintf(overlay, "%zu entities", entities);
+      ImGui::PlotLines("##profiler_entities", m_profiler.entity_history(),
+                       (int)filled, (int)offset, overlay, 0.f, FLT_MAX,
+                       ImVec2(size.x, 60.f));
+      for (const auto &[tag, name] : name_tags) {
+        ImGui::Text("%s: %zu", name.c_str(),
+                    m_entity_manager.get_entities(tag).size());
+        ImGui::SameLine();
+      }
+      ImGui::Text("particles: %zu", m_particles.live_count());
+      ImGui::EndTabItem();
+    }
     if (ImGui::BeginTabItem("Weapons")) {
       std::shared_ptr<Entity> player;
       for (auto e : m_entity_manager.get_entities(Tag::Player)) {
@@ -290,7 +490,7 @@ void Game::sGUI() {
         int &primary_power = player->weapon->power;
         int &secondary_power = player->special_weapon->power;
         const char min = 0;
-        const char max = read_config_i("Global", "maxPower");
+        const char max = m_params.max_power;
         const std::vector<std::string> primary_modes{"Single", "Spread",
                                                      "Laser"};
         const std::vector<std::string> secondary_modes{"Explosion", "Rotor",
@@ -797,18 +997,18 @@ void Game::sGUI() {
           resolutions.push_back(std::to_string(mode.width) + "x" + std::to_string(mode.height) + " (" + std::to_string(mode.bitsPerPixel) + ")");
         }
         const std::string current_refresh =
-            m_config["Window"]["refreshRate"];
+            read_config_s(config_key::window_refresh_rate);
         std::vector<std::string> refresh_rates{current_refresh, "144", "120",
                                                "60", "30"};
         const bool current_fullscreen =
-            (bool)read_config_i("Window", "fullscreen");
+            (bool)read_config_i(config_key::window_fullscreen);
         static int res_idx = 0;
         static int refresh_idx = 0;
         static bool fullscreen = current_fullscreen;
         const std::string current_res = 
-          read_config_s("Window", "width") + "x" +
-          read_config_s("Window", "height") + " (" +
-          read_config_s("Window", "depth") + ")";
+          read_config_s(config_key::window_width) + "x" +
+          read_config_s(config_key::window_height) + " (" +
+          read_config_s(config_key::window_depth) + ")";
         auto iterator = find(resolutions.begin(), resolutions.end(), current_res);
         if (iterator != resolutions.end()) {
           res_idx = iterator - resolutions.begin();
@@ -825,9 +1025,9 @@ void Game::sGUI() {
               // } else {
               //   res_warning = false;
               // }
-              write_config("Window", "width", std::to_string(m_video_modes[res_idx].width));
-              write_config("Window", "height", std::to_string(m_video_modes[res_idx].height));
-              write_config("Window", "depth", std::to_string(m_video_modes[res_idx].bitsPerPixel));
+              write_config(config_key::window_width, std::to_string(m_video_modes[res_idx].width));
+              write_config(config_key::window_height, std::to_string(m_video_modes[res_idx].height));
+              write_config(config_key::window_depth, std::to_string(m_video_modes[res_idx].bitsPerPixel));
             }
             if (is_selected) {
               ImGui::SetItemDefaultFocus();
@@ -848,7 +1048,7 @@ void Game::sGUI() {
               // } else {
               //   refresh_warning = false;
               // }
-              write_config("Window", "refreshRate", refresh_rates[refresh_idx]);
+              write_config(config_key::window_refresh_rate, refresh_rates[refresh_idx]);
             }
             if (is_selected) {
               ImGui::SetItemDefaultFocus();
@@ -859,7 +1059,7 @@ void Game::sGUI() {
         ImGui::SameLine();
         if (ImGui::Checkbox("fullscreen", &fullscreen)) {
           if (fullscreen != current_fullscreen) {
-            write_config("Window", "fullscreen", std::to_string((int)fullscreen));
+            write_config(config_key::window_fullscreen, std::to_string((int)fullscreen));
             // fullscreen_warning = true;
           } else {
             // fullscreen_warning = false;
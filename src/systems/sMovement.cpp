@@ -59,10 +59,13 @@ void Game::sMovement(const sf::Time &deltaTime) {
       entity->transform->position = pos;
     }
     if (entity->line && entity->transform) {
-      const Vec2 parent_pos = entity->line->parent.position;
-      const float parent_rot = entity->line->parent.rotation;
+      CLine &line = *entity->line.get();
+      const Vec2 parent_pos = line.parent.position;
+      const float parent_rot = line.parent.rotation;
       entity->transform->position = parent_pos;
       entity->transform->rotation = parent_rot;
+      line.world_start = parent_pos + line.start.clone().rotate_rad(parent_rot);
+      line.world_end = parent_pos + line.end.clone().rotate_rad(parent_rot);
     }
   }
 }
@@ -26,38 +26,25 @@ void Game::spawn_player() {
 
 void Game::setup_player(Entity &player, const Vec2 &position) {
   try {
-    const float shapeRadius = read_config_f("Player", "shapeRadius");
-    const float collisionRadius = read_config_f("Player", "collisionRadius");
-    const float speed = read_config_f("Player", "speed");
-    const int invincibilityDuration =
-        read_config_i("Player", "invincibilityDuration");
-    const int flickerRate = read_config_i("Player", "flickerRate");
-    const int fillRed = read_config_i("Player", "fillRed");
-    const int fillGreen = read_config_i("Player", "fillGreen");
-    const int fillBlue = read_config_i("Player", "fillBlue");
-    const int outlineRed = read_config_i("Player", "outlineRed");
-    const int outlineGreen = read_config_i("Player", "outlineGreen");
-    const int outlineBlue = read_config_i("Player", "outlineBlue");
-    const int outlineThickness = read_config_i("Player", "outlineThickness");
-    const int vertices = read_config_i("Player", "vertices");
-    const int health = read_config_i("Player", "health");
+    const PlayerParams &params = m_params.player;
 
     player.name = std::make_shared<CName>(CName("Player"));
     player.player =
-        std::make_shared<CPlayerStats>(CPlayerStats(3, speed, flickerRate));
+        std::make_shared<CPlayerStats>(CPlayerStats(3, params.speed, params.flicker_rate));
     player.transform = std::make_shared<CTransform>(CTransform(position));
     player.velocity = std::make_shared<CVelocity>(CVelocity());
     player.weapon =
         std::make_shared<CWeapon>(CWeapon(CWeapon::FireMode::ShotSingle));
     player.special_weapon = std::make_shared<CSpecialWeapon>(CSpecialWeapon());
-    player.shape = std::make_shared<CShape>(CShape(
-        shapeRadius, vertices, sf::Color(fillRed, fillGreen, fillBlue),
-        sf::Color(outlineRed, outlineGreen, outlineBlue), outlineThickness));
-    player.collider = std::make_shared<CCollider>(CCollider(collisionRadius));
+    player.shape = std::make_shared<CShape>(
+        CShape(params.shape_radius, params.vertices, params.fill_color,
+               params.outline_color, params.outline_thickness));
+    player.collider =
+        std::make_shared<CCollider>(CCollider(params.collision_radius));
     player.input = std::make_shared<CInput>(CInput());
-    player.health = std::make_shared<CHealth>(CHealth(health));
-    player.invincibility =
-        std::make_shared<CInvincibility>(CInvincibility(invincibilityDuration, invincibilityDuration));
+    player.health = std::make_shared<CHealth>(CHealth(params.health));
+    player.invincibility = std::make_shared<CInvincibility>(CInvincibility(
+        params.invincibility_duration, params.invincibility_duration));
     std::cout << "done\n";
   } catch (std::exception &e) {
     throw std::runtime_error(std::string(e.what(), sizeof(e.what())) +
@@ -1,39 +1,79 @@
 #include "../game.h"
 
 void Game::sRender(const sf::Time &deltaTime) {
-  m_window.clear();
-  // Render stuff
+  // Copy out what the render thread needs; it culls, batches and draws
+  // this frame while the next one is simulated
+  RenderSnapshot &snapshot = m_render_thread.back();
+  snapshot.clear();
+  snapshot.render = m_sRender;
+  snapshot.cull = m_cull;
+  snapshot.atlas = m_atlas;
+  snapshot.view_area = ViewCuller::view_area(m_window.getView());
   if (m_sRender) {
-    for (const std::shared_ptr<Entity> entity :
+    for (const std::shared_ptr<Entity> &entity :
          m_entity_manager.get_entities()) {
-      if (entity->shape) {
-        sf::CircleShape &shape = entity->shape->shape;
-        if (entity->transform) {
-          const Vec2 &pos = entity->transform->position;
-          shape.setPosition(sf::Vector2f(pos.x, pos.y));
-          shape.rotate(m_shape_rotation);
-        }
-        m_window.draw(shape);
+      RenderItem item;
+      // Fading out is derived from the time left, only for what is drawn
+      if (entity->lifespan) {
+        const CLifespan &lifespan = *entity->lifespan.get();
+        item.alpha = (sf::Uint8)(lifespan.countdown.remaining(m_tick) * 255 /
+                                 std::max(lifespan.duration, 1));
       }
-      if (entity->text && entity->transform) {
-        sf::Text &text = entity->text->text;
-        const Vec2 &pos = entity->transform->position;
-        text.setPosition(sf::Vector2f(pos.x, pos.y));
-        m_window.draw(text);
+      if (entity->shape && entity->transform) {
+        CShape &shape = *entity->shape.get();
+        shape.rotation = std::fmod(shape.rotation + m_shape_rotation, 360.f);
+        const float radius = shape.radius * shape.scale;
+        item.primitive = RenderItem::Primitive::Polygon;
+        item.position = entity->transform->position;
+        item.rotation = shape.rotation;
+        item.scale = shape.scale;
+        item.size = shape.radius;
+        item.point_count = m_governor.point_count(shape.point_count, radius);
+        item.key = entity->id();
+        item.version = shape.version;
+        item.fill_color = shape.fill_color;
+        item.outline_color = shape.outline_color;
+        item.outline_thickness =
+            m_governor.draw_outline(radius) ? shape.outline_thickness : 0.f;
+      } else if (entity->line) {
+        const CLine &line = *entity->line.get();
+        item.primitive = RenderItem::Primitive::Line;
+        item.position = line.world_start;
+        item.end = line.world_end;
+        item.size = line.thickness;
+        item.fill_color = fade(line.fill_color, item.alpha);
+        item.outline_color = fade(line.outline_color, item.alpha);
+        item.outline_thickness = line.outline_thickness;
+      } else if (entity->text && entity->transform) {
+        const CText &text = *entity->text.get();
+        item.primitive = RenderItem::Primitive::Text;
+        item.position = entity->transform->position;
+        item.scale = text.scale;
+        item.size = text.size;
+        item.string = snapshot.strings.size();
+        item.fill_color = fade(text.color, item.alpha);
+        snapshot.strings.push_back(text.string);
+      } else {
+        continue;
       }
-      if (entity->line) {
-        sf::RectangleShape &shape = entity->line->shape;
-        if (entity->transform) {
-          const float rot = entity->line->parent.rotation;
-          const Vec2 &pos = entity->line->parent.position +
-                            entity->line->start.clone().rotate_rad(rot);
-          shape.setPosition(sf::Vector2f(pos.x, pos.y));
-          shape.setRotation(rot * Vec2::rad_to_deg);
+      snapshot.items.push_back(item);
+    }
+    for (const ParticlePool &pool : m_particles.pools()) {
+      for (size_t i = 0; i < pool.size(); ++i) {
+        const size_t slot = pool.slot(i);
+        if (!pool.alive(slot) || !m_governor.draw_particle(slot)) {
+          continue;
         }
-        m_window.draw(shape);
+        RenderParticle particle;
+        particle.position = Vec2(pool.x(slot), pool.y(slot));
+        particle.rotation = pool.rotation(slot);
+        particle.radius = pool.radius(slot);
+        particle.point_count =
+            m_governor.point_count(pool.point_count(slot), particle.radius);
+        particle.color = pool.color(slot);
+        snapshot.particles.push_back(particle);
       }
     }
   }
-  ImGui::SFML::Render(m_window);
-  m_window.display();
+  m_render_thread.publish();
 }
@@ -33,12 +33,12 @@ void Game::sUserInput() {
     move_axis.x = 1;
   }
   if (sf::Mouse::isButtonPressed(sf::Mouse::Left)) {
-    if (!ImGui::GetIO().WantCaptureMouse && player) {
+    if (!m_gui_wants_mouse && player) {
       fire_input = true;
     }
   }
   if (sf::Mouse::isButtonPressed(sf::Mouse::Right)) {
-    if (!ImGui::GetIO().WantCaptureMouse && player) {
+    if (!m_gui_wants_mouse && player) {
       secondary_fire_input = true;
     }
   }
@@ -50,7 +50,8 @@ void Game::sUserInput() {
   }
 
   while (m_window.pollEvent(event)) {
-    ImGui::SFML::ProcessEvent(event);
+    // Handed to ImGui once the render thread is done with it
+    m_gui_events.push_back(event);
     if (event.type == sf::Event::Closed) {
       m_running = false;
     }
@@ -4,119 +4,56 @@ void Game::shoot() {
   for (const std::shared_ptr<Entity> player :
        m_entity_manager.get_entities(Tag::Player)) {
     if (player->weapon && player->transform) {
-      if (player->weapon->fire_countdown <= 0) {
+      if (player->weapon->fire_countdown.remaining(m_tick) <= 0) {
+        const WeaponParams &weapons = m_params.weapons;
+        const int power = player->weapon->power;
 
         switch (player->weapon->mode) {
         case (CWeapon::FireMode::ShotSingle): {
-          const std::string configHeader =
-              "ShotSingle" + std::to_string(player->weapon->power);
-          const float speed = read_config_f(configHeader, "speed");
-          const int fireRate = read_config_i(configHeader, "fireRate");
-          const int lifespan = read_config_i(configHeader, "lifespan");
-          const float collisionRadius =
-              read_config_f(configHeader, "collisionRadius");
-          const float shapeRadius = read_config_f(configHeader, "shapeRadius");
-          const int fillRed = read_config_i(configHeader, "fillRed");
-          const int fillGreen = read_config_i(configHeader, "fillGreen");
-          const int fillBlue = read_config_i(configHeader, "fillBlue");
-          const int outlineRed = read_config_i(configHeader, "outlineRed");
-          const int outlineGreen = read_config_i(configHeader, "outlineGreen");
-          const int outlineBlue = read_config_i(configHeader, "outlineBlue");
-          const int outlineThickness =
-              read_config_i(configHeader, "outlineThickness");
-          const int vertices = read_config_i(configHeader, "vertices");
-          const int health = read_config_i(configHeader, "health");
+          const ShotParams &shot = at_power(weapons.shot_single, power);
 
           const Vec2 position = player->transform->position.clone();
           const float rotation = player->transform->rotation;
           const Vec2 velocity =
-              Vec2::forward().rotate_rad(rotation).normalize() * speed;
+              Vec2::forward().rotate_rad(rotation).normalize() * shot.speed;
 
-          const CShape bullet_prefab = CShape(
-              shapeRadius, vertices, sf::Color(fillRed, fillGreen, fillBlue),
-              sf::Color(outlineRed, outlineGreen, outlineBlue),
-              outlineThickness);
-
-          spawn_bullet(position, rotation, velocity, bullet_prefab,
-                       collisionRadius, lifespan);
-          player->weapon->fire_countdown = fireRate;
+          spawn_bullet(position, rotation, velocity, shot.bullet,
+                       shot.collision_radius, shot.lifespan);
+          player->weapon->fire_countdown.start(m_tick, shot.fire_rate);
           break;
         }
         case (CWeapon::FireMode::ShotSpread): {
-          const std::string configHeader =
-              "ShotSpread" + std::to_string(player->weapon->power);
-          const float speed = read_config_f(configHeader, "speed");
-          const float spread = read_config_f(configHeader, "spread");
-          const int amount = read_config_i(configHeader, "amount");
-          const int fireRate = read_config_i(configHeader, "fireRate");
-          const int lifespan = read_config_i(configHeader, "lifespan");
-          const float collisionRadius =
-              read_config_f(configHeader, "collisionRadius");
-          const float shapeRadius = read_config_f(configHeader, "shapeRadius");
-          const int fillRed = read_config_i(configHeader, "fillRed");
-          const int fillGreen = read_config_i(configHeader, "fillGreen");
-          const int fillBlue = read_config_i(configHeader, "fillBlue");
-          const int outlineRed = read_config_i(configHeader, "outlineRed");
-          const int outlineGreen = read_config_i(configHeader, "outlineGreen");
-          const int outlineBlue = read_config_i(configHeader, "outlineBlue");
-          const int outlineThickness =
-              read_config_i(configHeader, "outlineThickness");
-          const int vertices = read_config_i(configHeader, "vertices");
-          const int health = read_config_i(configHeader, "health");
-
-          const CShape bullet_prefab = CShape(
-              shapeRadius, vertices, sf::Color(fillRed, fillGreen, fillBlue),
-              sf::Color(outlineRed, outlineGreen, outlineBlue),
-              outlineThickness);
+          const ShotParams &shot = at_power(weapons.shot_spread, power);
 
           const Vec2 position = player->transform->position.clone();
           const float rotation = player->transform->rotation;
           const Vec2 velocity =
-              Vec2::forward().rotate_rad(rotation).normalize() * speed;
-
-          const float spread_rad = spread / Vec2::rad_to_deg;
-          const float rot = spread_rad / amount;
-          Vec2 r_vel =
-              velocity.clone().rotate_rad(-rot * (((float)amount - 1) / 2));
-          for (int i = 0; i < amount; ++i) {
-            spawn_bullet(position, rot, r_vel, bullet_prefab, collisionRadius,
-                         lifespan);
+              Vec2::forward().rotate_rad(rotation).normalize() * shot.speed;
+
+          const float spread_rad = shot.spread / Vec2::rad_to_deg;
+          const float rot = spread_rad / shot.amount;
+          Vec2 r_vel = velocity.clone().rotate_rad(
+              -rot * (((float)shot.amount - 1) / 2));
+          std::vector<Vec2> velocities(std::max(shot.amount, 0));
+          for (Vec2 &vel : velocities) {
+            vel = r_vel;
             r_vel.rotate_rad(rot);
           }
-          player->weapon->fire_countdown = fireRate;
+          spawn_bullets(position, std::vector<float>(velocities.size(), rot),
+                        velocities, shot.bullet, shot.collision_radius,
+                        shot.lifespan);
+          player->weapon->fire_countdown.start(m_tick, shot.fire_rate);
           break;
         }
         case (CWeapon::FireMode::ShotLaser): {
-          const std::string configHeader =
-              "ShotLaser" + std::to_string(player->weapon->power);
-          const int fireRate = read_config_i(configHeader, "fireRate");
-          const int lifespan = read_config_i(configHeader, "lifespan");
-          const float offset = read_config_f(configHeader, "offset");
-          const float length = read_config_f(configHeader, "length");
-          const float thickness = read_config_f(configHeader, "thickness");
-          const int fillRed = read_config_i(configHeader, "fillRed");
-          const int fillGreen = read_config_i(configHeader, "fillGreen");
-          const int fillBlue = read_config_i(configHeader, "fillBlue");
-          const int fillAlpha = read_config_i(configHeader, "fillAlpha");
-          const int outlineRed = read_config_i(configHeader, "outlineRed");
-          const int outlineGreen = read_config_i(configHeader, "outlineGreen");
-          const int outlineBlue = read_config_i(configHeader, "outlineBlue");
-          const int outlineAlpha = read_config_i(configHeader, "outlineAlpha");
-          const int outlineThickness =
-              read_config_i(configHeader, "outlineThickness");
-
-          spawn_laser(
-              *player->transform.get(), // Parent transform
-              Vec2(offset, 0),          // Offset
-              length,                   // length
-              thickness,                // thickness
-              sf::Color(fillRed, fillGreen, fillBlue, fillAlpha), // Fill Color
-              sf::Color(outlineRed, outlineGreen, outlineBlue,
-                        outlineAlpha), // Outline Color
-              outlineThickness,        // Outline Thickness
-              lifespan                 // Lifespan
-          );
-          player->weapon->fire_countdown = fireRate;
+          const LaserParams &laser = at_power(weapons.shot_laser, power);
+
+          spawn_laser(*player->transform.get(), // Parent transform
+                      Vec2(laser.offset, 0),    // Offset
+                      laser.length, laser.thickness, laser.fill_color,
+                      laser.outline_color, laser.outline_thickness,
+                      laser.lifespan);
+          player->weapon->fire_countdown.start(m_tick, laser.fire_rate);
           break;
         }
         default:
@@ -144,6 +81,32 @@ Game::spawn_bullet(const Vec2 &position, const float rotation,
   return bullet;
 }
 
+// One bullet per rotation, all built in one go. Without velocities the
+// bullets get no CVelocity (like spawn_special_bullet).
+const Entities Game::spawn_bullets(const Vec2 &position,
+                                   const std::vector<float> &rotations,
+                                   const std::vector<Vec2> &velocities,
+                                   const CShape &bullet_prefab,
+                                   const float collision_radius,
+                                   const int lifespan) {
+  const Entities bullets =
+      m_entity_manager.add_entities(Tag::Bullets, rotations.size());
+  assign_components(bullets, &Entity::transform, [&](const size_t i) {
+    return CTransform(position, rotations[i]);
+  });
+  if (!velocities.empty()) {
+    assign_components(bullets, &Entity::velocity, [&](const size_t i) {
+      return CVelocity(velocities[i]);
+    });
+  }
+  assign_copies(bullets, &Entity::shape, bullet_prefab);
+  assign_copies(bullets, &Entity::collider, CCollider(collision_radius));
+  assign_copies(bullets, &Entity::name, CName("Bullet"));
+  assign_copies(bullets, &Entity::lifespan, CLifespan(lifespan));
+  assign_copies(bullets, &Entity::health, CHealth(1));
+  return bullets;
+}
+
 const std::shared_ptr<Entity>
 Game::spawn_laser(const CTransform &parent_transform, const Vec2 &offset,
                   const float length, const float thickness,
@@ -166,147 +129,72 @@ void Game::shootSpecialWeapon() {
   for (const std::shared_ptr<Entity> player :
        m_entity_manager.get_entities(Tag::Player)) {
     if (player->special_weapon && player->transform) {
-      if (player->special_weapon->fire_countdown <= 0) {
+      if (player->special_weapon->fire_countdown.remaining(m_tick) <= 0) {
+        const WeaponParams &weapons = m_params.weapons;
+        const int power = player->special_weapon->power;
 
         switch (player->special_weapon->mode) {
         case (CSpecialWeapon::FireMode::SpecialExplosion): {
-          const std::string configHeader =
-              "SpecialExplosion" +
-              std::to_string(player->special_weapon->power);
-
-          const int fireRate = read_config_i(configHeader, "fireRate");
-          const int lifespan = read_config_i(configHeader, "lifespan");
-          const int smallLifespan =
-              read_config_i(configHeader, "smallLifespan");
-          const int speed = read_config_i(configHeader, "speed");
-          const int smallSpeed = read_config_i(configHeader, "smallSpeed");
-          const int smallAmount = read_config_i(configHeader, "smallAmount");
-          const float collisionRadius =
-              read_config_f(configHeader, "collisionRadius");
-          const float shapeRadius = read_config_f(configHeader, "shapeRadius");
-          const int fillRed = read_config_i(configHeader, "fillRed");
-          const int fillGreen = read_config_i(configHeader, "fillGreen");
-          const int fillBlue = read_config_i(configHeader, "fillBlue");
-          const int outlineRed = read_config_i(configHeader, "outlineRed");
-          const int outlineGreen = read_config_i(configHeader, "outlineGreen");
-          const int outlineBlue = read_config_i(configHeader, "outlineBlue");
-          const int outlineThickness =
-              read_config_i(configHeader, "outlineThickness");
-          const int vertices = read_config_i(configHeader, "vertices");
-          const int health = read_config_i(configHeader, "health");
-          const int recursion = read_config_i(configHeader, "recursion");
+          const ExplosionParams &explosion =
+              at_power(weapons.special_explosion, power);
 
           const Vec2 position = player->transform->position.clone();
           const float rotation = player->transform->rotation;
           const Vec2 velocity =
-              Vec2::forward().rotate_rad(rotation).normalize() * speed;
-          const CShape bullet_prefab = CShape(
-              shapeRadius, vertices, sf::Color(fillRed, fillGreen, fillBlue),
-              sf::Color(outlineRed, outlineGreen, outlineBlue),
-              outlineThickness);
+              Vec2::forward().rotate_rad(rotation).normalize() *
+              explosion.speed;
 
           const std::shared_ptr<Entity> bullet = spawn_special_bullet(
-              position, rotation, bullet_prefab, collisionRadius, lifespan);
+              position, rotation, explosion.bullet, explosion.collision_radius,
+              explosion.lifespan);
           bullet->velocity = std::make_shared<CVelocity>(CVelocity(velocity));
-          bullet->spawner = std::make_shared<CDeathSpawner>(
-              CDeathSpawner(smallAmount, bullet_prefab, smallLifespan,
-                            smallSpeed, recursion, Tag::Bullets));
-          player->special_weapon->fire_countdown = fireRate;
+          bullet->spawner = std::make_shared<CDeathSpawner>(CDeathSpawner(
+              explosion.small_amount, explosion.bullet,
+              explosion.small_lifespan, explosion.small_speed,
+              explosion.recursion, Tag::Bullets));
+          player->special_weapon->fire_countdown.start(m_tick,
+                                                       explosion.fire_rate);
           break;
         }
         case (CSpecialWeapon::FireMode::SpecialRotor): {
-          const std::string configHeader =
-              "SpecialRotor" + std::to_string(player->special_weapon->power);
-
-          const float angularSpeed =
-              read_config_f(configHeader, "angularSpeed");
-          const int amount = read_config_i(configHeader, "amount");
-          const float radius = read_config_f(configHeader, "radius");
-          const int fireRate = read_config_i(configHeader, "fireRate");
-          const int lifespan = read_config_i(configHeader, "lifespan");
-          const float collisionRadius =
-              read_config_f(configHeader, "collisionRadius");
-          const float shapeRadius = read_config_f(configHeader, "shapeRadius");
-          const int fillRed = read_config_i(configHeader, "fillRed");
-          const int fillGreen = read_config_i(configHeader, "fillGreen");
-          const int fillBlue = read_config_i(configHeader, "fillBlue");
-          const int outlineRed = read_config_i(configHeader, "outlineRed");
-          const int outlineGreen = read_config_i(configHeader, "outlineGreen");
-          const int outlineBlue = read_config_i(configHeader, "outlineBlue");
-          const int outlineThickness =
-              read_config_i(configHeader, "outlineThickness");
-          const int vertices = read_config_i(configHeader, "vertices");
-          const int health = read_config_i(configHeader, "health");
-
-          const CShape bullet_prefab = CShape(
-              shapeRadius, vertices, sf::Color(fillRed, fillGreen, fillBlue),
-              sf::Color(outlineRed, outlineGreen, outlineBlue),
-              outlineThickness);
+          const RotorParams &rotor = at_power(weapons.special_rotor, power);
 
           const Vec2 position = player->transform->position.clone();
-          const float rotation = player->transform->rotation;
 
           const float spread_rad = 360.f / Vec2::rad_to_deg;
-          const float rot = spread_rad / amount;
+          const float rot = spread_rad / rotor.amount;
 
-          for (int i = 0; i < amount; ++i) {
-            const std::shared_ptr<Entity> bullet = spawn_special_bullet(
-                position, rot * i, bullet_prefab, collisionRadius, lifespan);
-            bullet->orbit = std::make_shared<COrbit>(
-                COrbit(*player->transform.get(), radius, angularSpeed));
+          std::vector<float> rotations(std::max(rotor.amount, 0));
+          for (size_t i = 0; i < rotations.size(); ++i) {
+            rotations[i] = rot * i;
           }
-          player->special_weapon->fire_countdown = fireRate;
+          const Entities bullets =
+              spawn_bullets(position, rotations, {}, rotor.bullet,
+                            rotor.collision_radius, rotor.lifespan);
+          assign_copies(bullets, &Entity::orbit,
+                        COrbit(*player->transform.get(), rotor.radius,
+                               rotor.angular_speed));
+          player->special_weapon->fire_countdown.start(m_tick,
+                                                       rotor.fire_rate);
           break;
         }
         case (CSpecialWeapon::FireMode::SpecialFlamethrower): {
-          const std::string configHeader =
-              "SpecialFlamethrower" +
-              std::to_string(player->special_weapon->power);
-          const float spread = read_config_f(configHeader, "spread");
-          const float nozzleSpread = read_config_f(configHeader, "nozzleSpread");
-          const int speed = read_config_i(configHeader, "speed");
-          const int duration = read_config_i(configHeader, "duration");
-          const int fireRate = read_config_i(configHeader, "fireRate");
-          const float offset = read_config_f(configHeader, "offset");
-          const int freq = read_config_i(configHeader, "freq");
-          const int quantity = read_config_i(configHeader, "quantity");
-          const int smallLifespan =
-              read_config_i(configHeader, "smallLifespan");
-          const float randomScale = read_config_f(configHeader, "randomScale");
-          const int fillRedMin = read_config_i(configHeader, "fillRedMin");
-          const int fillRedMax = read_config_i(configHeader, "fillRedMax");
-          const int fillGreenMin = read_config_i(configHeader, "fillGreenMin");
-          const int fillGreenMax = read_config_i(configHeader, "fillGreenMax");
-          const int fillBlue = read_config_i(configHeader, "fillBlue");
-          const int alphaMin = read_config_i(configHeader, "alphaMin");
-          const int alphaMax = read_config_i(configHeader, "alphaMax");
-          const int radiusMin = read_config_i(configHeader, "radiusMin");
-          const int radiusMax = read_config_i(configHeader, "radiusMax");
-          const int vertsMin = read_config_i(configHeader, "vertsMin");
-          const int vertsMax = read_config_i(configHeader, "vertsMax");
-          const int amountTypes = read_config_i(configHeader, "amountTypes");
+          const FlamethrowerParams &flame =
+              at_power(weapons.special_flamethrower, power);
 
-          const float spread_rad = spread / Vec2::rad_to_deg;
+          const float spread_rad = flame.spread / Vec2::rad_to_deg;
 
           std::vector<CShape> shapes{};
-          for (int i = 0; i < amountTypes; i++) {
-            const float radius =
-                (float)std::rand() / (float)RAND_MAX * (radiusMax - radiusMin) +
-                radiusMin;
-            const int verts = std::round((float)std::rand() / (float)RAND_MAX *
-                                             (vertsMax - vertsMin) +
-                                         vertsMin);
-            const int red = std::round((float)std::rand() / (float)RAND_MAX *
-                                           (fillRedMax - fillRedMin) +
-                                       fillRedMin);
-            const int green = std::round((float)std::rand() / (float)RAND_MAX *
-                                             (fillGreenMax - fillGreenMin) +
-                                         fillGreenMin);
-            const int alpha = std::round((float)std::rand() / (float)RAND_MAX *
-                                             (alphaMax - alphaMin) +
-                                         alphaMin);
+          Rng &rng = m_random.stream(RandomStreams::Weapons);
+          for (int i = 0; i < flame.amount_types; i++) {
+            const float radius = rng.uniform(flame.radius_min, flame.radius_max);
+            const int verts = rng.range(flame.verts_min, flame.verts_max);
+            const int red = rng.range(flame.fill_red_min, flame.fill_red_max);
+            const int green =
+                rng.range(flame.fill_green_min, flame.fill_green_max);
+            const int alpha = rng.range(flame.alpha_min, flame.alpha_max);
             shapes.push_back(CShape(radius, verts,
-                                    sf::Color(red, green, fillBlue, alpha),
+                                    sf::Color(red, green, flame.fill_blue, alpha),
                                     sf::Color(0, 0, 0, 0), // outline
                                     0                      // outline thickness
                                     ));
@@ -319,12 +207,14 @@ void Game::shootSpecialWeapon() {
           emitter->emitter = std::make_shared<CEmitter>(
               CEmitter(*player->transform.get(), // Parent transform
                        shapes,
-                       Vec2::forward() * offset, // Offset
-                       duration,
+                       Vec2::forward() * flame.offset, // Offset
+                       flame.duration,
                        spread_rad, // Spread angle
-                       nozzleSpread,
-                       speed, freq, quantity, smallLifespan, randomScale));
-          player->special_weapon->fire_countdown = fireRate;
+                       flame.nozzle_spread, flame.speed, flame.freq,
+                       flame.quantity, flame.small_lifespan,
+                       flame.random_scale));
+          player->special_weapon->fire_countdown.start(m_tick,
+                                                       flame.fire_rate);
           break;
         }
         default:
@@ -0,0 +1,136 @@
+#include "text_batch.h"
+
+void TextBatch::set_font(const sf::Font & font) {
+	m_font = &font;
+	m_layouts.clear();
+	m_pages.clear();
+}
+
+void TextBatch::clear() {
+	// Drop layouts that were not drawn last frame, e.g. old score values
+	for (auto it = m_layouts.begin(); it != m_layouts.end();) {
+		if (it->second.last_used + 1 < m_frame) {
+			it = m_layouts.erase(it);
+		} else {
+			++it;
+		}
+	}
+	for (auto & page : m_pages) {
+		page.second.clear();
+	}
+	m_glyph_count = 0;
+	++m_frame;
+}
+
+const TextBatch::Layout & TextBatch::layout(const std::string & text, const unsigned int size) {
+	Layout & cached = m_layouts[{size, text}];
+	cached.last_used = m_frame;
+	if (!cached.vertices.empty() || text.empty() || !m_font) {
+		return cached;
+	}
+
+	// Mirrors sf::Text::ensureGeometryUpdate for a regular, unscaled style
+	const sf::Font & font = *m_font;
+	const float whitespace_width = font.getGlyph(L' ', size, false).advance;
+	const float line_spacing = font.getLineSpacing(size);
+	const float padding = 1.f;
+	float x = 0.f;
+	float y = (float)size;
+	float min_x = (float)size;
+	float min_y = (float)size;
+	float max_x = 0.f;
+	float max_y = 0.f;
+	sf::Uint32 prev_char = 0;
+	for (const char ch : text) {
+		const sf::Uint32 cur_char = (unsigned char)ch;
+		if (cur_char == '\r') {
+			continue;
+		}
+		x += font.getKerning(prev_char, cur_char, size);
+		prev_char = cur_char;
+		if (cur_char == ' ' || cur_char == '\n' || cur_char == '\t') {
+			min_x = std::min(min_x, x);
+			min_y = std::min(min_y, y);
+			switch (cur_char) {
+				case ' ': x += whitespace_width; break;
+				case '\t': x += whitespace_width * 4; break;
+				case '\n': y += line_spacing; x = 0; break;
+			}
+			max_x = std::max(max_x, x);
+			max_y = std::max(max_y, y);
+			continue;
+		}
+
+		const sf::Glyph & glyph = font.getGlyph(cur_char, size, false);
+		const float left = glyph.bounds.left - padding;
+		const float top = glyph.bounds.top - padding;
+		const float right = glyph.bounds.left + glyph.bounds.width + padding;
+		const float bottom = glyph.bounds.top + glyph.bounds.height + padding;
+		const float u1 = glyph.textureRect.left - padding;
+		const float v1 = glyph.textureRect.top - padding;
+		const float u2 = glyph.textureRect.left + glyph.textureRect.width + padding;
+		const float v2 = glyph.textureRect.top + glyph.textureRect.height + padding;
+		const sf::Color white = sf::Color::White;
+		cached.vertices.push_back(sf::Vertex({x + left, y + top}, white, {u1, v1}));
+		cached.vertices.push_back(sf::Vertex({x + right, y + top}, white, {u2, v1}));
+		cached.vertices.push_back(sf::Vertex({x + left, y + bottom}, white, {u1, v2}));
+		cached.vertices.push_back(sf::Vertex({x + left, y + bottom}, white, {u1, v2}));
+		cached.vertices.push_back(sf::Vertex({x + right, y + top}, white, {u2, v1}));
+		cached.vertices.push_back(sf::Vertex({x + right, y + bottom}, white, {u2, v2}));
+
+		min_x = std::min(min_x, x + glyph.bounds.left);
+		max_x = std::max(max_x, x + glyph.bounds.left + glyph.bounds.width);
+		min_y = std::min(min_y, y + glyph.bounds.top);
+		max_y = std::max(max_y, y + glyph.bounds.top + glyph.bounds.height);
+		x += glyph.advance;
+	}
+	cached.bounds = sf::FloatRect(min_x, min_y, max_x - min_x, max_y - min_y);
+	return cached;
+}
+
+void TextBatch::add_text(
+	const Vec2 & position
+	, const std::string & text
+	, const unsigned int size
+	, const sf::Color & color
+	, const float scale
+) {
+	const Layout & cached = layout(text, size);
+	if (cached.vertices.empty() || color.a == 0) {
+		return;
+	}
+	sf::VertexArray & page = m_pages[size];
+	page.setPrimitiveType(sf::Triangles);
+	for (const sf::Vertex & local : cached.vertices) {
+		page.append(sf::Vertex(
+			sf::Vector2f(position.x + local.position.x * scale, position.y + local.position.y * scale),
+			color,
+			local.texCoords
+		));
+	}
+	m_glyph_count += cached.vertices.size() / 6;
+}
+
+sf::FloatRect TextBatch::measure(const std::string & text, const unsigned int size) {
+	return layout(text, size).bounds;
+}
+
+size_t TextBatch::glyph_count() const {
+	return m_glyph_count;
+}
+
+size_t TextBatch::cached_strings() const {
+	return m_layouts.size();
+}
+
+void TextBatch::draw(sf::RenderTarget & target, sf::RenderStates states) const {
+	if (!m_font) {
+		return;
+	}
+	for (const auto & page : m_pages) {
+		if (page.second.getVertexCount() > 0) {
+			states.texture = &m_font->getTexture(page.first);
+			target.draw(page.second, states);
+		}
+	}
+}
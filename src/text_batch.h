@@ -0,0 +1,46 @@
+#pragma once
+#include <map>
+#include <string>
+#include <vector>
+#include <SFML/Graphics/Color.hpp>
+#include <SFML/Graphics/Drawable.hpp>
+#include <SFML/Graphics/Font.hpp>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/RenderTarget.hpp>
+#include <SFML/Graphics/VertexArray.hpp>
+#include "vec2.h"
+
+// Lays out strings with the glyphs of one font (same layout as sf::Text)
+// and writes every string of a frame into one vertex array per character
+// size, so each size costs one texture bind and one draw call.
+// Laid out strings are cached, so an unchanged string is only copied.
+class TextBatch : public sf::Drawable {
+	struct Layout {
+		std::vector<sf::Vertex> vertices {}; // white, origin at top left
+		sf::FloatRect bounds {};
+		size_t last_used {0};
+	};
+	const sf::Font * m_font = nullptr;
+	std::map<std::pair<unsigned int, std::string>, Layout> m_layouts {};
+	std::map<unsigned int, sf::VertexArray> m_pages {};
+	size_t m_frame = 0;
+	size_t m_glyph_count = 0;
+	const Layout & layout(const std::string & text, const unsigned int size);
+public:
+	TextBatch() {};
+	~TextBatch() {};
+	void set_font(const sf::Font & font);
+	void clear();
+	void add_text(
+		const Vec2 & position
+		, const std::string & text
+		, const unsigned int size
+		, const sf::Color & color
+		, const float scale = 1.f
+	);
+	sf::FloatRect measure(const std::string & text, const unsigned int size);
+	size_t glyph_count() const;
+	size_t cached_strings() const;
+private:
+	void draw(sf::RenderTarget & target, sf::RenderStates states) const override;
+};
@@ -0,0 +1,57 @@
+#include "timing_wheel.h"
+#include <algorithm>
+
+void TimingWheel::place(Entry && entry, const size_t earliest) {
+	// The whole wheel spans slots^levels ticks, anything further is parked
+	// in the last slot it can reach and placed again from there
+	const size_t horizon = (size_t)1 << (slot_bits * levels);
+	const size_t due = std::min(std::max(entry.deadline, earliest), m_now + horizon - 1);
+	const size_t delta = due - m_now;
+	size_t level = 0;
+	while (level + 1 < levels && delta >= (size_t)1 << (slot_bits * (level + 1))) {
+		++level;
+	}
+	const size_t slot = (due >> (slot_bits * level)) & (slots - 1);
+	m_wheel[level][slot].push_back(std::move(entry));
+	++m_size;
+}
+
+void TimingWheel::cascade(const size_t level) {
+	if (level >= levels) {
+		return;
+	}
+	const size_t slot = (m_now >> (slot_bits * level)) & (slots - 1);
+	if (slot == 0) {
+		cascade(level + 1);
+	}
+	Slot entries {};
+	entries.swap(m_wheel[level][slot]);
+	m_size -= entries.size();
+	// Runs before the current tick's slot fires, so entries due now
+	// still make it
+	for (Entry & entry : entries) {
+		place(std::move(entry), m_now);
+	}
+}
+
+void TimingWheel::insert(const size_t deadline, const std::shared_ptr<Entity> & entity) {
+	place(Entry {deadline, entity}, m_now + 1);
+}
+
+void TimingWheel::clear() {
+	for (auto & level : m_wheel) {
+		for (Slot & slot : level) {
+			slot.clear();
+		}
+	}
+	m_firing.clear();
+	m_size = 0;
+}
+
+size_t TimingWheel::size() const {
+	return m_size;
+}
+
+size_t TimingWheel::now() const {
+	return m_now;
+}
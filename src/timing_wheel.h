@@ -0,0 +1,70 @@
+#pragma once
+#include <array>
+#include <memory>
+#include <vector>
+
+class Entity;
+
+// Hierarchical timing wheel (Varghese / Lauck) of entity deadlines, in
+// simulation ticks. Level 0 has one slot per tick for the next 64 ticks,
+// every level above covers 64 times the span of the one below. An entry
+// sits in the coarsest slot that still tells it apart and is moved down
+// a level whenever the wheel below wraps around to that slot, so inserting
+// and advancing cost the same no matter how many timers are waiting.
+// Entries only hold a weak reference: entities that die early are skipped,
+// and whoever fires them should check the deadline is still the one that
+// was scheduled, as timers can be restarted.
+class TimingWheel {
+public:
+	static constexpr size_t slot_bits = 6;
+	static constexpr size_t slots = 1 << slot_bits;
+	static constexpr size_t levels = 4;
+private:
+	struct Entry {
+		size_t deadline;
+		std::weak_ptr<Entity> entity;
+	};
+	typedef std::vector<Entry> Slot;
+	std::array<std::array<Slot, slots>, levels> m_wheel {};
+	size_t m_now = 0;
+	size_t m_size = 0;
+	Slot m_firing {};
+	void place(Entry && entry, const size_t earliest);
+	void cascade(const size_t level);
+public:
+	TimingWheel() {};
+	~TimingWheel() {};
+	// Fires on the first advance() that reaches deadline; deadlines that
+	// have already passed fire on the next one.
+	void insert(const size_t deadline, const std::shared_ptr<Entity> & entity);
+	// Steps the wheel one tick at a time up to now, calling fire(entity)
+	// for every live entity whose deadline was reached
+	template <typename Fire>
+	void advance(const size_t now, Fire fire);
+	// Drops every entry; the wheel keeps its current tick
+	void clear();
+	size_t size() const;
+	size_t now() const;
+};
+
+template <typename Fire>
+void TimingWheel::advance(const size_t now, Fire fire) {
+	while (m_now < now) {
+		++m_now;
+		if ((m_now & (slots - 1)) == 0) {
+			cascade(1);
+		}
+		// fire() may insert into the slot being emptied
+		m_firing.swap(m_wheel[0][m_now & (slots - 1)]);
+		m_size -= m_firing.size();
+		for (Entry & entry : m_firing) {
+			if (entry.deadline > m_now) {
+				// Further away than the wheel reaches, goes round again
+				place(std::move(entry), m_now + 1);
+			} else if (const std::shared_ptr<Entity> entity = entry.entity.lock()) {
+				fire(*entity.get());
+			}
+		}
+		m_firing.clear();
+	}
+}
@@ -0,0 +1,214 @@
+#include "trace.h"
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "config_writer.h"
+
+std::atomic<bool> Trace::s_recording {false};
+
+namespace {
+
+struct Event {
+	const char * name;
+	int64_t start; // ns since the capture began
+	int64_t end;
+};
+
+// Written only by the thread it belongs to. size is published with
+// release so the writer thread sees every event below it complete.
+struct ThreadBuffer {
+	std::string name {};
+	size_t tid {0};
+	std::unique_ptr<Event[]> events {}; // allocated by the first capture
+	std::atomic<size_t> capture {0}; // the capture the events belong to
+	std::atomic<size_t> size {0};
+	std::atomic<size_t> dropped {0};
+};
+
+// Registry and capture state; the mutex is only taken once per thread
+// (to register its buffer) and by the capture controls, never per event
+std::mutex registry_mutex;
+std::vector<std::unique_ptr<ThreadBuffer>> buffers;
+thread_local ThreadBuffer * local_buffer = nullptr;
+
+std::atomic<size_t> current_capture {0};
+// Read by every recording thread, so kept as a plain count of clock ticks
+std::atomic<Trace::Clock::rep> origin {0};
+Trace::Clock::time_point frame_start {};
+bool pending = false;
+std::atomic<size_t> frames_remaining {0};
+std::string capture_file {};
+std::thread writer {};
+std::atomic<bool> writing {false};
+std::string last_status {};
+
+ThreadBuffer & thread_buffer() {
+	if (!local_buffer) {
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		buffers.push_back(std::make_unique<ThreadBuffer>());
+		local_buffer = buffers.back().get();
+		local_buffer->tid = buffers.size();
+		local_buffer->name = "Thread " + std::to_string(local_buffer->tid);
+	}
+	return *local_buffer;
+}
+
+void append_escaped(std::string & out, const std::string & text) {
+	for (const char c : text) {
+		if (c == '"' || c == '\\') {
+			out += '\\';
+		}
+		out += c;
+	}
+}
+
+void write_capture(const size_t capture, const std::string & filename) {
+	std::string json = "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n";
+	size_t events = 0;
+	size_t dropped = 0;
+	char line[96];
+	{
+		// Threads that start now register a new buffer, the ones read
+		// here stay put
+		std::lock_guard<std::mutex> lock(registry_mutex);
+		for (const std::unique_ptr<ThreadBuffer> & buffer : buffers) {
+			json += "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":";
+			json += std::to_string(buffer->tid) + ",\"args\":{\"name\":\"";
+			append_escaped(json, buffer->name);
+			json += "\"}},\n";
+			if (buffer->capture.load(std::memory_order_acquire) != capture) {
+				continue;
+			}
+			const size_t size = buffer->size.load(std::memory_order_acquire);
+			for (size_t i = 0; i < size; ++i) {
+				const Event & event = buffer->events[i];
+				json += "{\"name\":\"";
+				append_escaped(json, event.name);
+				snprintf(line, sizeof(line), "\",\"ph\":\"X\",\"pid\":1,\"tid\":%zu,\"ts\":%.3f,\"dur\":%.3f},\n",
+					buffer->tid, event.start / 1000.0, (event.end - event.start) / 1000.0);
+				json += line;
+			}
+			events += size;
+			dropped += buffer->dropped.load(std::memory_order_relaxed);
+		}
+	}
+	// No trailing comma allowed
+	json.resize(json.size() - 2);
+	json += "\n]}\n";
+	std::string status;
+	try {
+		ConfigWriter::write_atomic(json, filename);
+		status = "Wrote " + filename + ": " + std::to_string(events) + " events";
+		if (dropped > 0) {
+			status += ", " + std::to_string(dropped) + " dropped";
+		}
+	} catch (std::exception & e) {
+		status = std::string("Trace not written: ") + e.what();
+	}
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	last_status = status;
+	writing = false;
+}
+
+}
+
+void Trace::set_thread_name(const char * name) {
+	ThreadBuffer & buffer = thread_buffer();
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	buffer.name = name;
+}
+
+bool Trace::capture(const size_t frames, const std::string & filename) {
+	if (frames == 0 || busy()) {
+		return false;
+	}
+	if (writer.joinable()) {
+		writer.join();
+	}
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	pending = true;
+	frames_remaining = frames;
+	capture_file = filename;
+	last_status = "Capturing";
+	return true;
+}
+
+void Trace::begin_frame() {
+	if (pending) {
+		pending = false;
+		origin.store(Clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+		// Buffers notice the new capture and start over on their next event
+		current_capture.fetch_add(1, std::memory_order_relaxed);
+		s_recording.store(true, std::memory_order_release);
+	}
+	frame_start = Clock::now();
+}
+
+void Trace::end_frame() {
+	if (!recording()) {
+		return;
+	}
+	record("Frame", frame_start, Clock::now());
+	if (frames_remaining.fetch_sub(1) > 1) {
+		return;
+	}
+	s_recording.store(false, std::memory_order_release);
+	writing = true;
+	writer = std::thread(write_capture, current_capture.load(), capture_file);
+}
+
+void Trace::record(const char * name, const Clock::time_point start, const Clock::time_point end) {
+	if (!recording()) {
+		return;
+	}
+	const Clock::time_point begin {Clock::duration {origin.load(std::memory_order_relaxed)}};
+	if (start < begin) {
+		// Started before this capture did
+		return;
+	}
+	ThreadBuffer & buffer = thread_buffer();
+	const size_t capture = current_capture.load(std::memory_order_relaxed);
+	if (buffer.capture.load(std::memory_order_relaxed) != capture) {
+		if (!buffer.events) {
+			buffer.events.reset(new Event[buffer_events]);
+		}
+		buffer.size.store(0, std::memory_order_relaxed);
+		buffer.dropped.store(0, std::memory_order_relaxed);
+		buffer.capture.store(capture, std::memory_order_release);
+	}
+	const size_t size = buffer.size.load(std::memory_order_relaxed);
+	if (size >= buffer_events) {
+		buffer.dropped.fetch_add(1, std::memory_order_relaxed);
+		return;
+	}
+	buffer.events[size] = Event {
+		name,
+		std::chrono::duration_cast<std::chrono::nanoseconds>(start - begin).count(),
+		std::chrono::duration_cast<std::chrono::nanoseconds>(end - begin).count(),
+	};
+	buffer.size.store(size + 1, std::memory_order_release);
+}
+
+bool Trace::busy() {
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	return pending || recording() || writing;
+}
+
+size_t Trace::frames_left() {
+	return frames_remaining.load(std::memory_order_relaxed);
+}
+
+std::string Trace::status() {
+	std::lock_guard<std::mutex> lock(registry_mutex);
+	return last_status;
+}
+
+void Trace::shutdown() {
+	s_recording.store(false, std::memory_order_release);
+	if (writer.joinable()) {
+		writer.join();
+	}
+}
@@ -0,0 +1,73 @@
+#pragma once
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <string>
+
+// Captures scoped events from every thread for a number of frames and
+// writes them as Chrome trace-event JSON (open in ui.perfetto.dev or
+// chrome://tracing). Each thread appends to a buffer of its own that no
+// other thread writes to, so recording never takes a lock. The file is
+// put together on a separate thread once the capture is over, so writing
+// it can't show up in the frames it describes.
+// Process wide on purpose: render, watcher and writer threads record
+// without being handed anything.
+class Trace {
+public:
+	typedef std::chrono::steady_clock Clock;
+	// Events kept per thread and capture, the rest are counted as dropped
+	static constexpr size_t buffer_events = 1 << 16;
+private:
+	static std::atomic<bool> s_recording;
+public:
+	// Names the calling thread in the trace
+	static void set_thread_name(const char * name);
+	// Records the next frames frames into filename, starting with the next
+	// begin_frame(). Ignored while a capture is running or being written.
+	static bool capture(const size_t frames, const std::string & filename);
+	// Frame boundaries, called by the simulation thread
+	static void begin_frame();
+	static void end_frame();
+	static bool recording() {
+		return s_recording.load(std::memory_order_acquire);
+	}
+	// name must outlive the capture (a string literal)
+	static void record(const char * name, const Clock::time_point start, const Clock::time_point end);
+	// Capturing or still writing the last capture
+	static bool busy();
+	static size_t frames_left();
+	// What happened to the last capture, for the GUI
+	static std::string status();
+	// Waits for the last file to be written
+	static void shutdown();
+};
+
+// Records the enclosing scope as one trace event while a capture runs.
+class TraceScope {
+	const char * m_name;
+	const bool m_active;
+	Trace::Clock::time_point m_start {};
+public:
+	TraceScope(const char * name)
+		: m_name(name)
+		, m_active(Trace::recording())
+	{
+		if (m_active) {
+			m_start = Trace::Clock::now();
+		}
+	}
+	~TraceScope() {
+		if (m_active) {
+			Trace::record(m_name, m_start, Trace::Clock::now());
+		}
+	}
+};
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+#ifdef PROFILER_ENABLED
+#define TRACE_SCOPE(name) \
+	const TraceScope PROFILE_CONCAT(trace_scope_, __LINE__)(name)
+#else
+#define TRACE_SCOPE(name)
+#endif
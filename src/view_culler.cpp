@@ -0,0 +1,65 @@
+#include "view_culler.h"
+#include <cmath>
+#include "vec2.h"
+
+void ViewCuller::clear() {
+	m_x.clear();
+	m_y.clear();
+	m_radius.clear();
+	m_visible.clear();
+	m_visible_count = 0;
+}
+
+size_t ViewCuller::add(const float x, const float y, const float radius) {
+	m_x.push_back(x);
+	m_y.push_back(y);
+	m_radius.push_back(radius);
+	return m_x.size() - 1;
+}
+
+void ViewCuller::cull(const sf::FloatRect & area) {
+	const size_t count = m_x.size();
+	m_visible.resize(count);
+	const float left = area.left;
+	const float top = area.top;
+	const float right = area.left + area.width;
+	const float bottom = area.top + area.height;
+	const float * x = m_x.data();
+	const float * y = m_y.data();
+	const float * radius = m_radius.data();
+	uint8_t * visible = m_visible.data();
+	size_t visible_count = 0;
+	for (size_t i = 0; i < count; ++i) {
+		const uint8_t inside =
+			(x[i] + radius[i] >= left) &
+			(x[i] - radius[i] <= right) &
+			(y[i] + radius[i] >= top) &
+			(y[i] - radius[i] <= bottom);
+		visible[i] = inside;
+		visible_count += inside;
+	}
+	m_visible_count = visible_count;
+}
+
+bool ViewCuller::visible(const size_t idx) const {
+	return m_visible[idx];
+}
+
+size_t ViewCuller::size() const {
+	return m_x.size();
+}
+
+size_t ViewCuller::visible_count() const {
+	return m_visible_count;
+}
+
+sf::FloatRect ViewCuller::view_area(const sf::View & view) {
+	const sf::Vector2f & center = view.getCenter();
+	const sf::Vector2f & size = view.getSize();
+	const float angle = view.getRotation() / Vec2::rad_to_deg;
+	const float cos_a = std::abs(std::cos(angle));
+	const float sin_a = std::abs(std::sin(angle));
+	const float width = size.x * cos_a + size.y * sin_a;
+	const float height = size.x * sin_a + size.y * cos_a;
+	return sf::FloatRect(center.x - width / 2.f, center.y - height / 2.f, width, height);
+}
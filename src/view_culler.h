@@ -0,0 +1,27 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+#include <SFML/Graphics/Rect.hpp>
+#include <SFML/Graphics/View.hpp>
+
+// Bounding circles of everything that wants to be drawn this frame,
+// kept as separate arrays so the overlap test against the view is one
+// flat, branch-free loop the compiler can vectorize.
+class ViewCuller {
+	std::vector<float> m_x {};
+	std::vector<float> m_y {};
+	std::vector<float> m_radius {};
+	std::vector<uint8_t> m_visible {};
+	size_t m_visible_count = 0;
+public:
+	ViewCuller() {};
+	~ViewCuller() {};
+	void clear();
+	size_t add(const float x, const float y, const float radius);
+	void cull(const sf::FloatRect & area);
+	bool visible(const size_t idx) const;
+	size_t size() const;
+	size_t visible_count() const;
+	// World-space rectangle covered by the view (its bounding box when rotated)
+	static sf::FloatRect view_area(const sf::View & view);
+};